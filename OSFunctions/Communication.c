@@ -4,6 +4,148 @@
 
 #include "Communication.h"
 
+static exception send_wait_common( mailbox *mBox, void* pData, uint nSize, uint nMicros );
+static exception receive_wait_common( mailbox* mBox, void* pData, uint *pSize, uint nMicros );
+static exception send_no_wait_common( mailbox* mBox, void* pData, uint nSize );
+static int receive_no_wait_common( mailbox* mBox, void* pData, uint *pSize );
+
+/** \brief  copy the data of one Message
+
+    Every Message, request and reply is copied here, nSize bytes.
+ */
+static void copy_msg( void* pDst, const void* pSrc, uint nSize ){
+  memcpy(pDst, pSrc, nSize);
+}
+
+/** \brief  block the running task until the Mailbox has room
+
+    The task waits in the room queue of the Mailbox, sorted by
+    deadline. Must be called with interrupts disabled, before the
+    SaveContext() of the calling kernel call, and returns with
+    interrupts disabled.
+
+    \param [in]    *mBox: a pointer to the Mailbox.
+    \param [in]    nExpiry: the expiry of the timeout in timer counts, 0 waits without timeout.
+    \return        OK when woken by a receiver, otherwise FAIL,
+                   TIMEOUT or DEADLINE_REACHED.
+ */
+static exception block_room( mailbox* mBox, utime nExpiry ){
+  volatile int firstExec = TRUE;
+  exception status;
+  SaveContext(); //Save context
+  if(firstExec){
+    firstExec=FALSE;
+    readyL->pHead->pNext->Status = OK;
+    //Start the timeout of a timed wait
+    if(nExpiry > 0 && start_timeout(readyL->pHead->pNext, nExpiry) == FAIL){
+      return FAIL;
+    }
+    msg *pWait = createMsg();
+    if(pWait == NULL){
+      cancel_timeout(readyL->pHead->pNext);
+      return FAIL;
+    }
+    pWait->pBlock = readyL->pHead->pNext;
+    readyL->pHead->pNext->pMessage = pWait;
+    insertRoom(mBox, pWait);
+    //Move sending task from Readylist to Waitinglist
+    insertRL(waitingL,extractRL(readyL));
+    uppdateRunning();
+    dispatch();//Load context
+  }
+  set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_SEND_WAIT); //Closed by the caller
+  if(readyL->pHead->pNext->Status != OK){//IF deadline or timeout is reached THEN
+    extractRoom(mBox, readyL->pHead->pNext->pMessage);
+    kmem_free(KOBJ_MSG, readyL->pHead->pNext->pMessage);
+    readyL->pHead->pNext->pMessage = NULL;
+    status = readyL->pHead->pNext->Status;
+    readyL->pHead->pNext->Status = OK;
+    miss_resume(); //Abort the job if that is its overload policy
+    return status;
+  }
+  return OK; //The receiver removed the room entry
+}
+
+/** \brief  wait until a send to the Mailbox will not find it full
+
+    Only a Mailbox set to MBOX_FULL_BLOCK waits, another receiver may
+    take the room first, so the task waits again then. All waits end
+    at the same expiry. Called and returns with interrupts disabled.
+
+    \param [in]    *mBox: a pointer to the Mailbox.
+    \param [in]    nExpiry: the expiry of the timeout in timer counts, 0 waits without timeout.
+    \return        OK when there is room, otherwise as block_room.
+ */
+static exception wait_room( mailbox* mBox, utime nExpiry ){
+  while(mBox->nFull == MBOX_FULL_BLOCK && mBox->nMessages >= mBox->nMaxMessages){
+    exception status;
+    if(nExpiry > 0 && now_counts() >= nExpiry){ //Expired in an earlier wait
+      return TIMEOUT;
+    }
+    status = block_room(mBox, nExpiry);
+    if(status != OK){
+      return status;
+    }
+  }
+  return OK;
+}
+
+/** \brief  make the first sender waiting for room ready
+
+    Called when a Message or a blocked sender left the Mailbox.
+    Senders already woken by their timeout or deadline are skipped,
+    they remove their own entry when they resume. The scheduling is
+    left to the caller.
+
+    \param [in]    *mBox: a pointer to the Mailbox.
+    \return        none
+ */
+static void wake_room( mailbox* mBox ){
+  msg *pWait = mBox->pRoom;
+  while(pWait != NULL && pWait->pBlock->Status != OK){
+    pWait = pWait->pNext;
+  }
+  if(pWait != NULL){
+    listobj *pObj = pWait->pBlock;
+    extractRoom(mBox, pWait);
+    kmem_free(KOBJ_MSG, pWait);
+    wake_task(pObj, OK);
+  }
+}
+
+/** \brief  end a call without a reply
+
+    The caller, if it still waits, is made ready with FAIL.
+
+    \param [in]    *pCall: the Message of the call, taken from its Mailbox.
+    \return        none
+ */
+static void cancel_call( msg* pCall ){
+  if(pCall->pBlock != NULL){
+    pCall->pBlock->pMessage = NULL;
+    wake_task(pCall->pBlock, FAIL);
+  }
+  kmem_free(KOBJ_MSG, pCall);
+}
+
+/** \brief  hand a call to the task that received it
+
+    The caller stays in the Waitinglist until reply(). A call the task
+    did not reply to is cancelled.
+
+    \param [in]    *pServer: the receiving task.
+    \param [in]    *pCall: the Message of the call, unlinked from its Mailbox.
+    \return        none
+ */
+static void take_call( TCB* pServer, msg* pCall ){
+  if(pServer->pCall != NULL){
+    cancel_call(pServer->pCall);
+  }
+  pCall->pNext = pCall->pPrevious = NULL; //Marks the call as taken
+  pServer->pCall = pCall;
+}
+
 
 /** \brief  create a Mailbox
 
@@ -17,10 +159,15 @@
  */
 mailbox* create_mailbox(uint nof_msg, uint size_of_msg)
 {
+#ifdef KERNEL_STATIC
+  if(size_of_msg > CFG_MSG_DATA_SIZE){//return NULL if Messages do not fit the data pool
+    return NULL;
+  }
+#endif
   //Allocate memory for the Mailbox
   mailbox *mailb_obj = create_mailB();
   if(mailb_obj == NULL){
-    return FAIL;
+    return NULL;
   }
   //Initialize Mailbox structure
   mailb_obj->nMaxMessages = nof_msg;
@@ -41,12 +188,8 @@ mailbox* create_mailbox(uint nof_msg, uint size_of_msg)
    
 exception remove_mailbox( mailbox* mBox ){
   if(mBox->pHead->pNext == mBox->pTail){//IF Mailbox is empty THEN  (NOT_EMPTY =0)
-    free(mBox->pHead);//Free the memory for the Mailbox
-    mymem_count_free++; 
-    free(mBox->pTail);//Free the memory for the Mailbox
-    mymem_count_free++; 
-    free(mBox);//Free the memory for the Mailbox
-    mymem_count_free++; 
+    remove_mailB(mBox);//Free the memory for the Mailbox
+    HEAP_LEAKS_OF(mBox); //Report what the Mailbox left behind
     return OK;//Return OK
   }//ELSE
   else{
@@ -65,6 +208,26 @@ int no_messages( mailbox* mBox ){
   return mBox->nMessages;
 }
 
+/** \brief  Set what a send to a full Mailbox does
+
+    MBOX_FULL_OVERWRITE is the default, send_no_wait overwrites the
+    oldest Message and send_wait fails. With MBOX_FULL_BLOCK both
+    wait until a receive makes room, in deadline order, so no Message
+    is lost. The wait ends with DEADLINE_REACHED, or with TIMEOUT when
+    the timeout of a timed send expires. Must be set before the Mailbox
+    is used. Lite tasks must not send to a blocking Mailbox, the wait
+    would block the lite runner. Interrupt handlers and work items
+    must not call send_no_wait on it either, the wait would block
+    the interrupted task or the work context.
+
+    \param [in]    Mailbox*: A pointer to the Mailbox.
+    \param [in]    nMode: MBOX_FULL_OVERWRITE or MBOX_FULL_BLOCK.
+    \return        none
+ */
+void set_mailbox_full( mailbox* mBox, uint nMode ){
+  mBox->nFull = nMode;
+}
+
 /** \brief  send a Message to the Mailbox 
 
   This call will send a Message to the specified Mailbox.
@@ -78,9 +241,10 @@ int no_messages( mailbox* mBox ){
   switch. During the blocking period of the task its
   deadline might be reached. At that point in time the
   blocked task will be resumed with the exception:
-  DEADLINE_REACHED. Note: send_wait and
-  send_no_wait Messages shall not be mixed in the
-  same Mailbox.
+  DEADLINE_REACHED. A full Mailbox makes the call fail,
+  or wait for room when it is set to MBOX_FULL_BLOCK.
+  Note: send_wait and send_no_wait Messages shall not
+  be mixed in the same Mailbox.
 
   \param [in]    Mailbox*: A pointer to the Mailbox.
   \param [in]    *Data: a pointer to a memory area where the data of
@@ -90,60 +254,145 @@ int no_messages( mailbox* mBox ){
   sending tasks deadline is reached while it is blocked by
   the send_wait call.
 */
-exception send_wait( mailbox *mBox, void* pData ){//recieve -
+exception send_wait( mailbox *mBox, void* pData ){
+  return send_wait_common(mBox, pData, mBox->nDataSize, 0);
+}
+
+/** \brief  send a Message to the Mailbox with a timeout
+
+  As send_wait, but a blocked sending task is also resumed when the
+  timeout expires, independent of its deadline. The timeout entry is
+  removed in constant time when the Message is received first.
+
+  \param [in]    Mailbox*: A pointer to the Mailbox.
+  \param [in]    *Data: a pointer to a memory area where the data of
+                        the communicated Message is residing.
+  \param [in]    nMicros: the timeout in microseconds, 0 waits without timeout.
+  \return        OK: Normal behavior, no exception occurred.
+  \return        TIMEOUT: the timeout expired before the Message was received.
+  \return        DEADLINE_REACHED: the sending tasks deadline is reached.
+*/
+exception send_wait_timeout( mailbox *mBox, void* pData, uint nMicros ){
+  return send_wait_common(mBox, pData, mBox->nDataSize, nMicros);
+}
+
+/** \brief  send a variable length Message to the Mailbox
+
+  As send_wait, but only the nSize bytes at pData are copied. The
+  receiver gets the length from receive_wait_len or receive_no_wait_len.
+  The data stays owned by the sender.
+
+  \param [in]    Mailbox*: A pointer to the Mailbox.
+  \param [in]    *Data: a pointer to the data of the Message.
+  \param [in]    nSize: the length of the data, at most nDataSize of the Mailbox.
+  \return        OK: Normal behavior, no exception occurred.
+  \return        FAIL: nSize is larger than the Messages of the Mailbox.
+  \return        DEADLINE_REACHED: the sending tasks deadline is reached.
+*/
+exception send_wait_len( mailbox *mBox, void* pData, uint nSize ){
+  return send_wait_common(mBox, pData, nSize, 0);
+}
+
+/** \brief  send_wait and send_wait_timeout
+
+    Common part of the blocking sends, nMicros is 0 without timeout.
+ */
+static exception send_wait_common( mailbox *mBox, void* pData, uint nSize, uint nMicros ){
   volatile int firstExec = TRUE;
-  int x = set_isr(isr_off); //Disable interrupt
+  exception status;
+  utime nExpiry;
+  if(nSize > (uint)mBox->nDataSize){//return fail if the Message does not fit
+    return FAIL;
+  }
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_SEND_WAIT);
+  nExpiry = timeout_at(nMicros); //One timeout for the waits for room and the send
+  status = wait_room(mBox, nExpiry); //A blocking Mailbox is never full below
+  if(status != OK){
+    ISR_EXIT();
+    set_isr(x);
+    return status;
+  }
   SaveContext(); //Save context
   if(firstExec){//IF first execution THEN
     firstExec=FALSE;//Set: not first execution any more
+    readyL->pHead->pNext->Status = OK;
     if(mBox->nMessages<0 /*&& mBox->nBlockedMsg<0*/ ){//IF receiving task is waiting THEN
       //Copy senders data to the data area of the receivers Message
-      memcpy(mBox->pHead->pNext->pData,pData , mBox->nDataSize);//(DEST,SRS,SIZE)
+      copy_msg(mBox->pHead->pNext->pData, pData, nSize);//(DEST,SRS,SIZE)
+      if(mBox->pHead->pNext->pSize != NULL){
+        *mBox->pHead->pNext->pSize = nSize;
+      }
       //str1(pData) -- This is pointer to the destination array where the content
       // is to be copied, type-casted to a pointer of type void*.
       //*Remove receiving tasks Message struct from the mailbox
       struct l_obj  *list_pobj = mBox->pHead->pNext->pBlock;
+      MSG_SEND(mBox->pHead->pNext); //Delivered at once
+      MSG_RECEIVE(mBox, mBox->pHead->pNext, list_pobj->pTask);
       remove_MBoxmsg(mBox->pHead->pNext);
       mBox->nMessages += SENDER; //+1
       mBox->nBlockedMsg += SENDER; //+1
       //Move receiving task to Readylist
-      insertRL(readyL,extractWL(waitingL, list_pobj));
-      uppdateRunning();
+      wake_task(list_pobj, OK);
       
     }//ELSE
     else{
-      if(mBox->nMessages > 0 && mBox->nBlockedMsg == 0 ) // return fail if there  are 
-        return FAIL;                                 //send_no_wait in mailbox
-      if(mBox->nMaxMessages == mBox->nMessages) //return fail if mailbox is full
+      if(mBox->nMessages > 0 && mBox->nBlockedMsg == 0 ){ // return fail if there  are 
+        ISR_EXIT();                                       //send_no_wait in mailbox
+        set_isr(x);
+        return FAIL;
+      }
+      if(mBox->nMaxMessages == mBox->nMessages){ //return fail if mailbox is full
+        ISR_EXIT();
+        set_isr(x);
         return FAIL;
+      }
+      //Start the timeout of a timed wait
+      if(nExpiry > 0 && start_timeout(readyL->pHead->pNext, nExpiry) == FAIL){
+        ISR_EXIT();
+        set_isr(x);
+        return FAIL;
+      }
       //Allocate a Message structure
       msg *msg_Obj = createMsg();
       if(msg_Obj==NULL){//return fail if the MSG_obj is not allocated
+        cancel_timeout(readyL->pHead->pNext);
+        ISR_EXIT();
+        set_isr(x);
         return FAIL;
       }
       //Set data pointer
       msg_Obj->pData=pData;
+      msg_Obj->nSize=nSize;
       msg_Obj->pBlock = readyL->pHead->pNext;
       readyL->pHead->pNext->pMessage = msg_Obj;
+      MSG_SEND(msg_Obj);
       //Add Message to the Mailbox
       insertMB(mBox, msg_Obj);
       mBox->nMessages += SENDER;
       mBox->nBlockedMsg += SENDER; //+1
       //Move sending task from Readylist to Waitinglist
       insertRL(waitingL,extractRL(readyL));
+      lite_notify(mBox);
       uppdateRunning();
     }//ENDIF
-    LoadContext();//Load context
+    dispatch();//Load context
   }//ELSE
   else{
-    if(Running->DeadLine<=TC){//IF deadline is reached THEN
-      x = set_isr(isr_off); //Disable interrupt
+    if(readyL->pHead->pNext->Status != OK){//IF deadline or timeout is reached THEN
+      x = set_isr(ISR_OFF); //Disable interrupt
+      ISR_ENTER(ISR_SITE_SEND_WAIT);
       //Remove send Message       
       remove_msgRL(readyL);
       mBox->nMessages   += RECEIVER; //-1
       mBox->nBlockedMsg += RECEIVER; //-1
+      wake_room(mBox);
+      status = readyL->pHead->pNext->Status;
+      readyL->pHead->pNext->Status = OK;
+      miss_resume(); //Abort the job if that is its overload policy
+      ISR_EXIT();
       set_isr(x);  //isr_on();      //Enable interrupt
-      return DEADLINE_REACHED;//Return DEADLINE_REACHED
+      return status;//Return DEADLINE_REACHED or TIMEOUT
     }//ELSE
     else{
       return OK;//Return OK
@@ -178,40 +427,111 @@ exception send_wait( mailbox *mBox, void* pData ){//recieve -
                   tasks deadline is reached while it is blocked by the receive_waitcall.
  */                  //recieve                      //sendData
 exception receive_wait( mailbox* mBox, void* pData ){
+  return receive_wait_common(mBox, pData, NULL, 0);
+}
+
+/** \brief  receive a Message from Mailbox with a timeout
+
+    As receive_wait, but a blocked receiving task is also resumed
+    when the timeout expires, independent of its deadline. The
+    timeout entry is removed in constant time when a Message
+    arrives first.
+
+    \param [in]    *mBox: a pointer to the specified Mailbox.
+    \param [in]    *Data: a pointer to a memory area where the data of
+                               the communicated Message is to be stored.
+    \param [in]    nMicros: the timeout in microseconds, 0 waits without timeout.
+    \return        OK: Normal function, no exception occurred.
+    \return        TIMEOUT: the timeout expired before a Message arrived.
+    \return        DEADLINE_REACHED: the receiving tasks deadline is reached.
+ */
+exception receive_wait_timeout( mailbox* mBox, void* pData, uint nMicros ){
+  return receive_wait_common(mBox, pData, NULL, nMicros);
+}
+
+/** \brief  receive a variable length Message from Mailbox
+
+    As receive_wait, but the length of the received Message is returned
+    in *pSize. The data area must hold nDataSize bytes of the Mailbox,
+    only the length of the Message is written to it.
+
+    \param [in]    *mBox: a pointer to the specified Mailbox.
+    \param [in]    *Data: a pointer to the data area of the receiver.
+    \param [out]   *pSize: the length of the received Message.
+    \return        OK: Normal function, no exception occurred.
+    \return        DEADLINE_REACHED: the receiving tasks deadline is reached.
+ */
+exception receive_wait_len( mailbox* mBox, void* pData, uint *pSize ){
+  return receive_wait_common(mBox, pData, pSize, 0);
+}
+
+/** \brief  receive_wait and receive_wait_timeout
+
+    Common part of the blocking receives, nMicros is 0 without timeout.
+ */
+static exception receive_wait_common( mailbox* mBox, void* pData, uint *pSize, uint nMicros ){
   volatile int firstExec = TRUE;
-  int x = set_isr(isr_off); //Disable interrupt
+  exception status;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_RECEIVE_WAIT);
   SaveContext(); //Save context
   if(firstExec){//IF first execution THEN
     firstExec=FALSE;//Set: not first execution any more
+    readyL->pHead->pNext->Status = OK;
     if(mBox->nMessages>0 /*&& mBox->nBlockedMsg>0*/ ){//IF send Message is waiting THEN
       //Copy senders data to receiving tasks data area
-      memcpy(pData,mBox->pHead->pNext->pData , mBox->nDataSize);//(DEST,SRS(copyfrom),SIZE)
+      copy_msg(pData, mBox->pHead->pNext->pData, mBox->pHead->pNext->nSize);//(DEST,SRS(copyfrom),SIZE)
+      if(pSize != NULL){
+        *pSize = mBox->pHead->pNext->nSize;
+      }
+      MSG_RECEIVE(mBox, mBox->pHead->pNext, Running);
       //Remove sending tasks Message struct from the Mailbox
       void *pdata_temp = mBox->pHead->pNext->pData;
       // remove_MBoxmsg(mBox->pHead->pNext);
       //IF Message was of wait type THEN Move sending task to Ready list        (pblock?)
       int typewait=0;//if block
       
-      if (mBox->pHead->pNext->pBlock->pMessage !=NULL && mBox-> nBlockedMsg != 0)  {
+      if (mBox->pHead->pNext->pReply != NULL) { //IF Message is a call THEN the caller waits for reply
+        msg *pCall = mBox->pHead->pNext;
+        typewait = 1;
+        mBox->nMessages += RECEIVER; //-1
+        mBox->nBlockedMsg += RECEIVER; //-1
+        pCall->pPrevious->pNext = pCall->pNext;
+        pCall->pNext->pPrevious = pCall->pPrevious;
+        take_call(Running, pCall);
+      }
+      else if (mBox->pHead->pNext->pBlock != NULL && mBox->pHead->pNext->pBlock->pMessage !=NULL && mBox-> nBlockedMsg != 0)  {
         typewait = 1;
         mBox->nMessages += RECEIVER; //-1
         mBox->nBlockedMsg += RECEIVER; //-1
-        insertRL(readyL,extractWL(waitingL, mBox->pHead->pNext->pBlock));
+        wake_task(mBox->pHead->pNext->pBlock, OK);
         remove_MBoxmsg(mBox->pHead->pNext); //Remove Message struct
-        uppdateRunning();
       }else{
         if(typewait==0){// if send_no_wait
           remove_MBoxmsg(mBox->pHead->pNext);
-          free(pdata_temp);//Free senders data area
+          kmem_free(KOBJ_DATA, pdata_temp);//Free senders data area
           mBox->nMessages+= RECEIVER;
         }
       }//ENDIF
+      wake_room(mBox); //A sender may wait for the room
     }//ELSE
     else{
+      //Start the timeout of a timed wait
+      if(nMicros > 0 && start_timeout(readyL->pHead->pNext, timeout_at(nMicros)) == FAIL){
+        ISR_EXIT();
+        set_isr(x);
+        return FAIL;
+      }
       //Allocate a Message structure
       msg *msg_Obj = createMsg();
-      
+      if(msg_Obj==NULL){//return fail if the MSG_obj is not allocated
+        cancel_timeout(readyL->pHead->pNext);
+        ISR_EXIT();
+        set_isr(x);
+        return FAIL;
+      }
       msg_Obj->pData = pData; //
+      msg_Obj->pSize = pSize; //Set by the sender
       msg_Obj->pBlock = readyL->pHead->pNext; //
       readyL->pHead->pNext->pMessage = msg_Obj;
       //Add Message to the Mailbox
@@ -222,18 +542,23 @@ exception receive_wait( mailbox* mBox, void* pData ){
       insertRL(waitingL,extractRL(readyL));
       uppdateRunning();
     }//ENDIF
-    LoadContext();//Load context
+    dispatch();//Load context
   }//ELSE
   else {
-    if(Running->DeadLine<=TC){//IF deadline is reached THEN
-       x = set_isr(isr_off);   //Disable interrupt
+    if(readyL->pHead->pNext->Status != OK){//IF deadline or timeout is reached THEN
+       x = set_isr(ISR_OFF);   //Disable interrupt
+       ISR_ENTER(ISR_SITE_RECEIVE_WAIT);
       //Remove receive Message
       remove_msgRL(readyL);
       //remove_MBoxmsg(readyL->pHead->pNext->pMessage);
       mBox->nMessages += SENDER; //-1
       mBox->nBlockedMsg += SENDER; //-1
+      status = readyL->pHead->pNext->Status;
+      readyL->pHead->pNext->Status = OK;
+      miss_resume(); //Abort the job if that is its overload policy
+      ISR_EXIT();
       set_isr(x);  //isr_on();//Enable interrupt
-      return DEADLINE_REACHED;//Return DEADLINE_REACHED
+      return status;//Return DEADLINE_REACHED or TIMEOUT
     }//ELSE
     else{
       return OK;//Return OK
@@ -249,7 +574,9 @@ exception receive_wait( mailbox* mBox, void* pData ){
     This call will send a Message to the specified Mailbox.
     The sending task will continue execution after the call.
     When the Mailbox is full, the oldest Message will be
-    overwritten. The send_no_wait call will imply a new
+    overwritten, or the task waits for room when the Mailbox is
+    set to MBOX_FULL_BLOCK, so it must not be called from an interrupt
+    handler on such a Mailbox. The send_no_wait call will imply a new
     scheduling and possibly a context switch.
     Note: send_wait and send_no_wait Messages shall not be
     mixed in the same Mailbox.
@@ -260,35 +587,85 @@ exception receive_wait( mailbox* mBox, void* pData ){
     \return        FAIL/OK: Description of the functions status. 
  */
 exception send_no_wait( mailbox* mBox, void* pData ){
+  return send_no_wait_common(mBox, pData, mBox->nDataSize);
+}
+
+/** \brief  send a variable length Message to the Mailbox
+
+    As send_no_wait, but only the nSize bytes at pData are copied. The
+    data is placed in a kernel owned buffer of the smallest size class
+    that fits, see KernelMem.h. The buffer is released when the Message
+    is received or overwritten, pData stays owned by the sender.
+
+    \param [in]    *mBox: a pointer to the specified Mailbox
+    \param [in]    *pData: a pointer to the data of the Message.
+    \param [in]    nSize: the length of the data, at most nDataSize of the Mailbox.
+    \return        FAIL/OK: Description of the function's status.
+ */
+exception send_no_wait_len( mailbox* mBox, void* pData, uint nSize ){
+  return send_no_wait_common(mBox, pData, nSize);
+}
+
+/** \brief  send_no_wait and send_no_wait_len
+ */
+static exception send_no_wait_common( mailbox* mBox, void* pData, uint nSize ){
   volatile int firstExec = TRUE;
-  int x = set_isr(isr_off); //Disable interrupt
+  if(nSize > (uint)mBox->nDataSize){//return fail if the Message does not fit
+    return FAIL;
+  }
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_SEND_NO_WAIT);
+  if(wait_room(mBox, 0) != OK){ //A blocking Mailbox is never full below
+    ISR_EXIT();
+    set_isr(x);
+    return FAIL;
+  }
   SaveContext(); //Save context
   if(firstExec){//IF first execution THEN
     firstExec=FALSE;//Set: not first execution any more
     if(/*mBox->nMessages<0 &&*/ mBox->nBlockedMsg<0 ){//IF receiving task is waiting THEN
       //Copy senders data to the data area of the receivers Message
-      memcpy(mBox->pHead->pNext->pData,pData , mBox->nDataSize);//(DEST,SRS,SIZE)
+      copy_msg(mBox->pHead->pNext->pData, pData, nSize);//(DEST,SRS,SIZE)
+      if(mBox->pHead->pNext->pSize != NULL){
+        *mBox->pHead->pNext->pSize = nSize;
+      }
       //*Remove receiving tasks Message struct from the mailbox
       struct l_obj  *list_pobj = mBox->pHead->pNext->pBlock;
+      MSG_SEND(mBox->pHead->pNext); //Delivered at once
+      MSG_RECEIVE(mBox, mBox->pHead->pNext, list_pobj->pTask);
       remove_MBoxmsg(mBox->pHead->pNext);
       mBox->nMessages += SENDER; //+1
       mBox->nBlockedMsg += SENDER; //+1
       //Move receiving task to Readylist
-      insertRL(readyL,extractWL(waitingL, list_pobj));
-      uppdateRunning();
-      LoadContext();//Load context
+      wake_task(list_pobj, OK);
+      dispatch();//Load context
     }//ELSE
     else{
-      if(mBox->nBlockedMsg > 0) //return fail if there is send_wait in mailbox
+      if(mBox->nBlockedMsg > 0){ //return fail if there is send_wait in mailbox
+        ISR_EXIT();
+        set_isr(x);
         return FAIL;
+      }
       //Allocate a Message structure
       msg *msg_Obj = createMsg();
       if (msg_Obj== NULL) {
+        ISR_EXIT();
+        set_isr(x);
         return FAIL;
       }
-      //Copy Data to the Message
-      msg_Obj->pData = pData;
-      memcpy(msg_Obj->pData,pData,mBox->nDataSize);
+      //Copy Data to the Message, the data area is owned by the Message
+      msg_Obj->pData = createMsgData(nSize);
+      if (msg_Obj->pData == NULL) {
+        kmem_free(KOBJ_MSG, msg_Obj);
+        ISR_EXIT();
+        set_isr(x);
+        return FAIL;
+      }
+      copy_msg(msg_Obj->pData, pData, nSize);
+      msg_Obj->nSize = nSize;
+      HEAP_OWNER(msg_Obj, mBox); //The Message now belongs to the Mailbox
+      HEAP_OWNER(msg_Obj->pData, mBox);
+      MSG_SEND(msg_Obj);
       //IF mailbox is full THEN
       if(mBox->nMessages == mBox->nMaxMessages){
         //Remove the oldest Message struct
@@ -299,8 +676,12 @@ exception send_no_wait( mailbox* mBox, void* pData ){
       insertMB(mBox, msg_Obj);
       msg_Obj->pBlock = NULL;
       mBox->nMessages++;
+      if(lite_notify(mBox)){//A lite task waits for the Message
+        dispatch();//Load context
+      }
     }//ENDIF
   }//ENDIF
+  ISR_EXIT();
   set_isr(x);
   return OK;//Return status
 }
@@ -322,43 +703,235 @@ exception send_no_wait( mailbox* mBox, void* pData ){
 
  */
 int receive_no_wait( mailbox* mBox, void* pData ){
+  return receive_no_wait_common(mBox, pData, NULL);
+}
+
+/** \brief  receive a variable length Message from the Mailbox
+
+    As receive_no_wait, but the length of the received Message is
+    returned in *pSize. The data area must hold nDataSize bytes of the
+    Mailbox, the kernel buffer of the Message is released.
+
+    \param [in]    *mBox: a pointer to the specified Mailbox
+    \param [in]    *pData: a pointer to the data area of the receiver.
+    \param [out]   *pSize: the length of the received Message.
+    \return        OK/FAIL  Integer indicating whether or not a Message was received.
+ */
+int receive_no_wait_len( mailbox* mBox, void* pData, uint *pSize ){
+  return receive_no_wait_common(mBox, pData, pSize);
+}
+
+/** \brief  receive_no_wait and receive_no_wait_len
+ */
+static int receive_no_wait_common( mailbox* mBox, void* pData, uint *pSize ){
   
   volatile int firstExec = TRUE;
-  int x = set_isr(isr_off); //Disable interrupt
+  volatile int status = FAIL;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_RECEIVE_NO_WAIT);
   SaveContext(); //Save context
   if(firstExec){//IF first execution THEN
     firstExec=FALSE;//Set: not first execution any more
     
     
     if(mBox->nMessages>0 /*&& mBox->nBlockedMsg>0*/){//IF send Message is waiting THEN
+      status = OK;
       //Copy senders data to receiving tasks data area
-      memcpy(pData,mBox->pHead->pNext->pData , mBox->nDataSize);//(DEST,SRS(copyfrom),SIZE)
+      copy_msg(pData, mBox->pHead->pNext->pData, mBox->pHead->pNext->nSize);//(DEST,SRS(copyfrom),SIZE)
+      if(pSize != NULL){
+        *pSize = mBox->pHead->pNext->nSize;
+      }
+      MSG_RECEIVE(mBox, mBox->pHead->pNext, Running);
       //Remove sending tasks Message struct from the Mailbox
       void *pdata_temp = mBox->pHead->pNext->pData;
       // remove_MBoxmsg(mBox->pHead->pNext);
       //IF Message was of wait type THEN Move sending task to Ready list        (pblock?)
       int typewait=0;//if block
       
-      if (mBox->pHead->pNext->pBlock->pMessage !=NULL && mBox-> nBlockedMsg != 0)  {
+      if (mBox->pHead->pNext->pReply != NULL) { //IF Message is a call THEN the caller waits for reply
+        msg *pCall = mBox->pHead->pNext;
+        typewait = 1;
+        mBox->nMessages += RECEIVER; //-1
+        mBox->nBlockedMsg += RECEIVER; //-1
+        pCall->pPrevious->pNext = pCall->pNext;
+        pCall->pNext->pPrevious = pCall->pPrevious;
+        take_call(Running, pCall);
+      }
+      else if (mBox->pHead->pNext->pBlock != NULL && mBox->pHead->pNext->pBlock->pMessage !=NULL && mBox-> nBlockedMsg != 0)  {
         typewait = 1;
         mBox->nMessages += RECEIVER; //-1
         mBox->nBlockedMsg += RECEIVER; //-1
-        insertRL(readyL,extractWL(waitingL, mBox->pHead->pNext->pBlock));
+        wake_task(mBox->pHead->pNext->pBlock, OK);
         remove_MBoxmsg(mBox->pHead->pNext);
-        uppdateRunning();
       }else{
         if(typewait==0){ //if send_no_wait
           remove_MBoxmsg(mBox->pHead->pNext);
-          free(pdata_temp);//Free senders data area
+          kmem_free(KOBJ_DATA, pdata_temp);//Free senders data area
           mBox->nMessages+= RECEIVER;
         }
       }//ENDIF
+      wake_room(mBox); //A sender may wait for the room
     }//ELSE
-    LoadContext();//Load context
+    dispatch();//Load context
   }//ENDIF
   //Return status on received Message
+  ISR_EXIT();
   set_isr(x);
-  return OK; 
+  return status; 
+}
+
+
+/** \brief  call a server task and wait for its reply
+
+    Sends the request as send_wait does and blocks once, until the
+    server has received it and called reply(). The reply is copied
+    straight into pReply, so a round trip takes one blocking call
+    instead of a send_wait and a receive_wait. Request and reply have
+    the size of the Messages of the Mailbox.
+
+    \param [in]    *mBox: a pointer to the Mailbox of the server.
+    \param [in]    *pRequest: the request.
+    \param [out]   *pReply: the data area of the reply.
+    \return        OK: the reply was received.
+    \return        FAIL: the Mailbox holds send_no_wait Messages or is full,
+                   or the server did not reply before its next call.
+    \return        DEADLINE_REACHED: the calling tasks deadline is reached.
+ */
+exception call( mailbox* mBox, void* pRequest, void* pReply ){
+  volatile int firstExec = TRUE;
+  exception status;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_CALL);
+  status = wait_room(mBox, 0); //A blocking Mailbox is never full below
+  if(status != OK){
+    ISR_EXIT();
+    set_isr(x);
+    return status;
+  }
+  SaveContext(); //Save context
+  if(firstExec){//IF first execution THEN
+    firstExec=FALSE;
+    listobj *pClient = readyL->pHead->pNext;
+    pClient->Status = OK;
+    if(mBox->nMessages > 0 && (mBox->nBlockedMsg == 0 || mBox->nMessages == mBox->nMaxMessages)){
+      ISR_EXIT(); //return fail if there are send_no_wait Messages or the Mailbox is full
+      set_isr(x);
+      return FAIL;
+    }
+    msg *msg_Obj = createMsg();
+    if(msg_Obj == NULL){
+      ISR_EXIT();
+      set_isr(x);
+      return FAIL;
+    }
+    msg_Obj->pData = pRequest;
+    msg_Obj->nSize = mBox->nDataSize;
+    msg_Obj->pReply = pReply;
+    msg_Obj->pBlock = pClient;
+    pClient->pMessage = msg_Obj;
+    MSG_SEND(msg_Obj);
+    if(mBox->nMessages < 0){//IF the server is waiting THEN hand the request over
+      msg *pServer = mBox->pHead->pNext;
+      listobj *pObj = pServer->pBlock;
+      copy_msg(pServer->pData, pRequest, msg_Obj->nSize);
+      if(pServer->pSize != NULL){
+        *pServer->pSize = msg_Obj->nSize;
+      }
+      MSG_RECEIVE(mBox, msg_Obj, pObj->pTask);
+      remove_MBoxmsg(pServer);
+      mBox->nMessages += SENDER; //+1
+      mBox->nBlockedMsg += SENDER; //+1
+      take_call(pObj->pTask, msg_Obj);
+      wake_task(pObj, OK);
+    }//ELSE
+    else{
+      insertMB(mBox, msg_Obj);
+      mBox->nMessages += SENDER;
+      mBox->nBlockedMsg += SENDER; //+1
+      lite_notify(mBox);
+    }//ENDIF
+    //Move calling task from Readylist to Waitinglist until the reply. The
+    //server or the lite runner made ready above may be at the head by now.
+    insertRL(waitingL,extractWL(readyL, pClient));
+    uppdateRunning();
+    dispatch();//Load context
+  }//ELSE
+  else{
+    if(readyL->pHead->pNext->Status != OK){//IF deadline is reached or the call was cancelled THEN
+      x = set_isr(ISR_OFF); //Disable interrupt
+      ISR_ENTER(ISR_SITE_CALL);
+      msg *pCall = readyL->pHead->pNext->pMessage;
+      if(pCall != NULL && pCall->pNext != NULL){ //Not received yet
+        remove_msgRL(readyL);
+        mBox->nMessages   += RECEIVER; //-1
+        mBox->nBlockedMsg += RECEIVER; //-1
+        wake_room(mBox);
+      }
+      else if(pCall != NULL){ //The server holds it, reply() frees it
+        pCall->pBlock = NULL;
+        readyL->pHead->pNext->pMessage = NULL;
+      }
+      status = readyL->pHead->pNext->Status;
+      readyL->pHead->pNext->Status = OK;
+      miss_resume(); //Abort the job if that is its overload policy
+      ISR_EXIT();
+      set_isr(x);
+      return status;
+    }//ENDIF
+  }//ENDIF
+  return OK;
+}
+
+/** \brief  reply to the call received last
+
+    Copies the reply into the data area of the caller and makes it
+    ready, which may cause a context switch. A server must reply to
+    a call before it receives the next one, that one cancels it.
+
+    \param [in]    *pReply: the reply, of the size of the Messages of the Mailbox.
+    \return        OK: the caller got the reply.
+    \return        FAIL: there is no call, or its caller has reached its deadline.
+ */
+exception reply( void* pReply ){
+  volatile int firstExec = TRUE;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_CALL);
+  SaveContext(); //Save context
+  if(firstExec){//IF first execution THEN
+    firstExec=FALSE;
+    msg *pCall = Running->pCall;
+    if(pCall == NULL){
+      ISR_EXIT();
+      set_isr(x);
+      return FAIL;
+    }
+    Running->pCall = NULL;
+    if(pCall->pBlock == NULL){ //The caller is gone
+      kmem_free(KOBJ_MSG, pCall);
+      ISR_EXIT();
+      set_isr(x);
+      return FAIL;
+    }
+    copy_msg(pCall->pReply, pReply, pCall->nSize);
+    wake_task(pCall->pBlock, OK);
+    kmem_free(KOBJ_MSG, pCall);
+    dispatch();//Load context
+  }//ENDIF
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  cancel the call a terminating task has not replied to
+
+    \param [in]    *pTask: the task.
+    \return        none
+ */
+void drop_call( TCB* pTask ){
+  if(pTask->pCall != NULL){
+    cancel_call(pTask->pCall);
+    pTask->pCall = NULL;
+  }
 }
 
 
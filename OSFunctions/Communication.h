@@ -2,6 +2,8 @@
 #define Com_H
 #include "Listor.h"
 #include "TimerFunctions.h"
+#include "Lite.h"
+#include "MsgStats.h"
 
 /*******************************************************************************
  *                 Inter-Process Communication
@@ -13,7 +15,16 @@ exception remove_mailbox( mailbox* mBox );
 int no_messages( mailbox* mBox );
 exception send_wait( mailbox *mBox, void* pData );
 exception receive_wait( mailbox* mBox, void* pData );
+exception send_wait_timeout( mailbox *mBox, void* pData, uint nMicros );
+exception receive_wait_timeout( mailbox* mBox, void* pData, uint nMicros );
 exception send_no_wait( mailbox* mBox, void* pData );
 int receive_no_wait( mailbox* mBox, void* pData );
+exception send_wait_len( mailbox *mBox, void* pData, uint nSize );
+exception receive_wait_len( mailbox* mBox, void* pData, uint *pSize );
+exception send_no_wait_len( mailbox* mBox, void* pData, uint nSize );
+int receive_no_wait_len( mailbox* mBox, void* pData, uint *pSize );
+exception call( mailbox* mBox, void* pRequest, void* pReply );
+exception reply( void* pReply );
+void drop_call( TCB* pTask );
 
 #endif
\ No newline at end of file
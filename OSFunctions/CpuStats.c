@@ -0,0 +1,160 @@
+/**************************************************************************//**
+ * @file     CpuStats.c
+ * @brief    ART Real Time Micro Kernel CpuStats.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 CPU time accounting
+******************************************************************************/
+
+#include "CpuStats.h"
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+#define cpuStamp        (pKernel->cpuStamp)     /**< time of the last change of Running. */
+
+/** \brief  move the counters of a task to the current window
+
+    The counters of the window before are kept, older ones are dropped.
+
+    \param [in]      pTask: the task
+    \param [in]      nWindow: the current window
+    \return          none
+ */
+static void cpu_roll(TCB *pTask, uint nWindow){
+  if(pTask->nWindow != nWindow){
+    if(pTask->nWindow + 1 == nWindow){
+      pTask->nPrevCpu = pTask->nCpu;
+      pTask->nPrevSwitches = pTask->nSwitches;
+    }
+    else{
+      pTask->nPrevCpu = 0;
+      pTask->nPrevSwitches = 0;
+    }
+    pTask->nCpu = 0;
+    pTask->nSwitches = 0;
+    pTask->nWindow = nWindow;
+  }
+}
+
+/** \brief  account a change of Running
+
+    Charges the time since the last change to the task that ran and
+    counts the switch of the next one. Called by uppdateRunning() with
+    interrupts disabled.
+
+    \param [in]      pOld: the task that ran, NULL if it was terminated
+    \param [in]      pNew: the task that runs next
+    \return          none
+ */
+void cpu_switch(TCB *pOld, TCB *pNew){
+  utime nNow = now_counts();
+  uint nWindow = TC / CPU_WINDOW_TICKS;
+  if(pOld != NULL){
+    cpu_roll(pOld, nWindow);
+    pOld->nCpu += (uint)(nNow - cpuStamp);
+  }
+  cpu_roll(pNew, nWindow);
+  pNew->nSwitches++;
+  cpuStamp = nNow;
+}
+
+/** \brief  load of a task over the sliding window
+
+    The window before is weighted by the part of it that is still
+    inside the sliding window.
+
+    \param [in]      nCur: counter of the current window
+    \param [in]      nPrev: counter of the window before
+    \return          the counter over the sliding window
+ */
+static uint cpu_slide(uint nCur, uint nPrev){
+  uint nLeft = CPU_WINDOW_TICKS - TC % CPU_WINDOW_TICKS;
+  return nCur + (uint)((utime)nPrev * nLeft / CPU_WINDOW_TICKS);
+}
+
+/** \brief  top style snapshot of the CPU load
+
+    Returns the load of every task over the last CPU_WINDOW_TICKS,
+    Idle included. Tasks are visited in the Readylists, Waitinglist and
+    Timerlist with interrupts disabled, so the call is O(tasks). Loads
+    are parts of the time the sliding window spans, so what the listed
+    tasks and Idle leave of 1000 is the work context and the cyclic
+    executive, which are in no list.
+
+    \param [out]     pLoad: room for nMax task loads
+    \param [in]      nMax: size of pLoad
+    \param [out]     pIdle: load of the idle task in 1/1000, may be NULL
+    \return          the number of tasks, can be larger than nMax
+ */
+uint cpu_top(taskload *pLoad, uint nMax, uint *pIdle){
+  list *aList[3];
+  partition *pPart = partFirst;
+  utime nTotal;
+  utime nNow;
+  uint nIdle = 0;
+  uint nTasks = 0;
+  uint i, n;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_CPU_STATS);
+  nNow = now_counts();
+  //The window spans CPU_WINDOW_TICKS up to the last tick and the time since
+  nTotal = (utime)CPU_WINDOW_TICKS*TIMER_TICK_COUNTS + nNow % TIMER_TICK_COUNTS;
+  if(nTotal > nNow){//Shorter since start
+    nTotal = nNow;
+  }
+  aList[0] = readyMain;
+  aList[1] = waitingL;
+  aList[2] = timmerL;
+  cpu_switch(Running, Running);//Charge the running task up to now
+  Running->nSwitches--;
+  for(i = 0; i < 3 || pPart != NULL; i++){//The kernel lists, then those of the partitions
+    list *pList = i < 3 ? aList[i] : pPart->pReady;
+    listobj *pObj;
+    if(i >= 3){
+      pPart = pPart->pNext;
+    }
+    for(pObj = pList->pHead->pNext; pObj != pList->pTail; pObj = pObj->pNext){
+      TCB *pTask = pObj->pTask;
+      if(pTask == NULL){//Timeout entry
+        continue;
+      }
+      cpu_roll(pTask, TC / CPU_WINDOW_TICKS);
+      uint nCpu = cpu_slide(pTask->nCpu, pTask->nPrevCpu);
+      if(pTask->Body == Idle){
+        nIdle = nCpu;
+      }
+      if(nTasks < nMax){
+        pLoad[nTasks].pTask = pTask;
+        pLoad[nTasks].Body = pTask->Body;
+        pLoad[nTasks].nLoad = nCpu;
+        pLoad[nTasks].nSwitches = cpu_slide(pTask->nSwitches, pTask->nPrevSwitches);
+      }
+      nTasks++;
+    }
+  }
+  ISR_EXIT();
+  set_isr(x);
+  n = nTasks < nMax ? nTasks : nMax;
+  for(i = 0; i < n; i++){//Counts to 1/1000 of the window
+    pLoad[i].nLoad = nTotal > 0 ? (uint)((utime)pLoad[i].nLoad * 1000 / nTotal) : 0;
+  }
+  if(pIdle != NULL){
+    *pIdle = nTotal > 0 ? (uint)((utime)nIdle * 1000 / nTotal) : 0;
+  }
+  return nTasks;
+}
@@ -0,0 +1,22 @@
+/**
+ * @file CpuStats.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the per task CPU time accounting.
+ *
+ * The time between two changes of Running is charged to the task that
+ * ran, measured on the timer time base. Loads are reported over a
+ * sliding window of CPU_WINDOW_TICKS.
+ */
+
+#ifndef CpuStats_H
+#define CpuStats_H
+#include "kernel.h"
+#include "TaskAdministration.h"
+
+#define CPU_WINDOW_TICKS 100    /**< length of the load window in ticks. */
+
+void cpu_switch(TCB *pOld, TCB *pNew);
+uint cpu_top(taskload *pLoad, uint nMax, uint *pIdle);
+
+#endif
@@ -0,0 +1,185 @@
+/**************************************************************************//**
+ * @file     Cyclic.c
+ * @brief    ART Real Time Micro Kernel Cyclic.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Time-triggered cyclic executive
+******************************************************************************/
+
+#include "Cyclic.h"
+#include "Overload.h"
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+// State of the current kernel instance, see KernelCtx.h
+#define pCyclic         (pKernel->pCyclic)      /**< the schedule, NULL without one. */
+#define cyclicObj       (pKernel->cyclicObj)    /**< list item of the executive task. */
+#define cyclicTick      (pKernel->cyclicTick)   /**< tick in the major frame. */
+#define cyclicMinor     (pKernel->cyclicMinor)  /**< tick in the minor frame. */
+#define cyclicSlot      (pKernel->cyclicSlot)   /**< next slot of the table. */
+#define cyclicNext      (pKernel->cyclicNext)   /**< first slot released but not started. */
+#define cyclicPending   (pKernel->cyclicPending) /**< slots released but not started. */
+#define cyclicOverruns  (pKernel->cyclicOverruns) /**< minor frames ended with a body running. */
+#define cyclicSkipped   (pKernel->cyclicSkipped)  /**< slots not started in their minor frame. */
+
+/** \brief  executive task
+
+    Runs the body of the slot, then the bodies of the slots released
+    while it ran, in table order, and hands over to the Readylist. The
+    next slot starts it again from the top of its stack.
+
+    \param [in]      none
+    \return          none
+ */
+static void cyclic_job(void){
+  const cyclic_slot *pSlot;
+  while(1){
+    Running->Body(); //Set by cyclic_release
+    set_isr(ISR_OFF); //Disable interrupt
+    ISR_ENTER(ISR_SITE_CYCLIC);
+    if(cyclicPending == 0){
+      break;
+    }
+    do{ //Slots left to Idle are not counted
+      pSlot = &pCyclic->pSlot[cyclicNext];
+      if(++cyclicNext == pCyclic->nSlots){
+        cyclicNext = 0;
+      }
+    }while(pSlot->pBody == NULL);
+    cyclicPending--;
+    Running->Body = pSlot->pBody;
+    ISR_EXIT();
+    set_isr(ISR_ON);
+  }
+  cyclicJob = NULL;
+  uppdateRunning();
+  ISR_EXIT();
+  LoadContext(); //The context of the job is not kept
+}
+
+/** \brief  start the slot at the current tick
+
+    Resets the context of the executive task to the start of the slot
+    body. A slot whose offset is reached while the body before is still
+    running is left pending and started by cyclic_job when that body
+    returns. Must be called with interrupts disabled.
+
+    \param [in]      none
+    \return          none
+ */
+static void cyclic_release(void){
+  const cyclic_slot *pSlot = &pCyclic->pSlot[cyclicSlot];
+  TCB *pTask = cyclicObj->pTask;
+  if(pSlot->nOffset != cyclicTick){
+    return;
+  }
+  if(++cyclicSlot == pCyclic->nSlots){
+    cyclicSlot = 0;
+  }
+  if(pSlot->pBody == NULL){ //Left to Idle
+    return;
+  }
+  if(cyclicJob != NULL){
+    if(cyclicPending++ == 0){
+      cyclicNext = (uint)(pSlot - pCyclic->pSlot);
+    }
+    return;
+  }
+  pTask->PC = cyclic_job;
+  pTask->SP = &(pTask->StackSeg[STACK_SIZE-1]);
+  pTask->SPSR = 0;
+  pTask->Body = pSlot->pBody;
+  cyclicJob = pTask;
+}
+
+/** \brief  set the time-triggered schedule
+
+    Must be called in start up mode after init_kernel, the major frame
+    starts at run. The offsets of the slots must increase and be below
+    nMajor, nMajor must be a multiple of nMinor.
+
+    \param [in]    pTable: the schedule, it must stay valid.
+    \return        FAIL/OK: FAIL for a bad table, in running mode or
+                            when the executive task cannot be created.
+ */
+exception set_cyclic(const cyclic_table* pTable){
+  uint i;
+  if(kernelMode == RUNNING || pCyclic != NULL || pTable == NULL ||
+     pTable->nSlots == 0 || pTable->nMinor == 0 || pTable->nMajor % pTable->nMinor != 0){
+    return FAIL;
+  }
+  for(i = 0; i < pTable->nSlots; i++){
+    if(pTable->pSlot[i].nOffset >= pTable->nMajor ||
+       (i > 0 && pTable->pSlot[i].nOffset <= pTable->pSlot[i-1].nOffset)){
+      return FAIL;
+    }
+  }
+  cyclicObj = new_task(cyclic_job, NO_DEADLINE); //Never in a list
+  if(cyclicObj == NULL){
+    return FAIL;
+  }
+  cyclicObj->pTask->Policy = MISS_KERNEL;
+  pCyclic = pTable;
+  cyclicTick = 0;
+  cyclicMinor = 0;
+  cyclicSlot = 0;
+  cyclicPending = 0;
+  cyclic_release();
+  uppdateRunning();
+  return OK;
+}
+
+/** \brief  overruns of the schedule
+
+    \param [out]     pSkipped: slots dropped because they were still
+                               queued at a minor frame boundary,
+                               may be NULL
+    \return          minor frames that ended with a body running
+ */
+uint cyclic_overruns(uint *pSkipped){
+  if(pSkipped != NULL){
+    *pSkipped = cyclicSkipped;
+  }
+  return cyclicOverruns;
+}
+
+/** \brief  advance the schedule by one tick
+
+    Called by TimerInt when TC is incremented, Running is updated by
+    the caller.
+
+    \param [in]      none
+    \return          none
+ */
+void cyclic_tick(void){
+  if(pCyclic == NULL){
+    return;
+  }
+  if(++cyclicTick == pCyclic->nMajor){
+    cyclicTick = 0;
+  }
+  if(++cyclicMinor == pCyclic->nMinor){
+    cyclicMinor = 0;
+    if(cyclicJob != NULL){
+      cyclicOverruns++;
+    }
+    cyclicSkipped += cyclicPending; //Too late for the next frame
+    cyclicPending = 0;
+  }
+  cyclic_release();
+}
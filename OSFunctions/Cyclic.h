@@ -0,0 +1,37 @@
+/**
+ * @file Cyclic.h
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the time-triggered cyclic executive.
+ *
+ * With a cyclic_table set in start up mode the tick interrupt starts
+ * the slot bodies at their tick offsets in the major frame, without
+ * a scheduling decision or a Readylist insert. A slot body runs to
+ * completion on the stack of the executive task, the next slot does
+ * not preempt it. Slots whose offset is reached while a body runs are
+ * queued and started back to back, in table order, when it returns.
+ * At each minor frame boundary the slots still queued are dropped and
+ * counted as skipped, and the frame is counted as an overrun when a
+ * body is still running; that body is left to complete. Both counts
+ * are read with cyclic_overruns().
+ *
+ * The executive task is not in the Readylist, so a slot body must not
+ * make kernel calls that act on the calling task: the blocking and
+ * _wait calls, wait, set_deadline, terminate, call and send_no_wait on
+ * an MBOX_FULL_BLOCK Mailbox. The _no_wait calls, publish, post_work
+ * and the timer calls may be used.
+ *
+ * Between slots the Readylist runs as usual, with no other tasks that
+ * is Idle. The tables are built offline by tools/cyclic-gen.py.
+ */
+
+#ifndef Cyclic_H
+#define Cyclic_H
+#include "kernel.h"
+#include "TaskAdministration.h"
+
+exception set_cyclic(const cyclic_table* pTable);
+uint cyclic_overruns(uint *pSkipped);
+void cyclic_tick(void);
+
+#endif
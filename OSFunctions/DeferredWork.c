@@ -0,0 +1,191 @@
+/**************************************************************************//**
+ * @file     DeferredWork.c
+ * @brief    ART Real Time Micro Kernel DeferredWork.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Deferred interrupt work
+******************************************************************************/
+
+#include "DeferredWork.h"
+#include "TaskAdministration.h"
+#include "TimerFunctions.h"
+#include "Overload.h"
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+// State of the current kernel instance, see KernelCtx.h
+#define workQueue       (pKernel->workQueue)    /**< ring buffer of posted work items. */
+#define workHead        (pKernel->workHead)     /**< next free slot, written by the poster. */
+#define workTail        (pKernel->workTail)     /**< next item to run, written by the kernel. */
+#define tickPending     (pKernel->tickPending)  /**< TRUE while the tick work is due. */
+#define workObj         (pKernel->workObj)      /**< the work context. */
+
+/** \brief  post deferred work
+
+    This call queues a work item that the kernel will run at
+    the next scheduling point, at the latest at the next tick.
+    It is constant time and may be called from interrupt handlers
+    and from tasks.
+
+    \param [in]    pFunc: the function to run.
+    \param [in]    pArg:  the argument given to pFunc.
+    \return        FAIL/OK: FAIL if the queue is full.
+ */
+exception post_work(workfn pFunc, void *pArg){
+  int x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_WORK);
+  if(workHead - workTail == WORK_QUEUE_SIZE){ //return fail if the queue is full
+    ISR_EXIT();
+    set_isr(x);
+    return FAIL;
+  }
+  workQueue[workHead & (WORK_QUEUE_SIZE-1)].pFunc = pFunc;
+  workQueue[workHead & (WORK_QUEUE_SIZE-1)].pArg = pArg;
+  workHead++;
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  post the tick work
+
+    This function is not available for the user to call.
+    Called by TimerInt with interrupts disabled. The tick work has a
+    flag of its own instead of a queue slot, so a queue filled by
+    interrupt handlers or tasks can not stop the ticks.
+
+    \param [in]    none
+    \return        none
+ */
+void post_tick(void){
+  tickPending = TRUE;
+}
+
+/** \brief  return number of pending work items
+
+    \param [in]    none
+    \return        the number of items waiting in the queue, the
+                   tick work counted as one
+ */
+uint pending_work(void){
+  return workHead - workTail + (tickPending ? 1 : 0);
+}
+
+/** \brief  run all pending work items
+
+    This function is not available for the user to call.
+    The tick work runs first. Items posted while the queue is
+    drained are run in the same call, so the queue is empty on
+    return.
+
+    \param [in]      none
+    \return          none
+ */
+void drain_work(void){
+  workitem item;
+  while(1){
+    if(tickPending){
+      tickPending = FALSE; //A tick during tick_work posts it again
+      tick_work();
+    }
+    else if(workTail != workHead){
+      item = workQueue[workTail & (WORK_QUEUE_SIZE-1)];
+      workTail++;
+      item.pFunc(item.pArg);
+    }
+    else{
+      break;
+    }
+  }
+}
+
+/** \brief  body of the work context
+
+    Started fresh by work_context() each time there is work. It drains
+    the queue with interrupts enabled until it stays empty, then it
+    schedules the task with the tightest deadline. Interrupts only
+    post work while it runs, TimerInt does not switch tasks.
+
+    \param [in]      none
+    \return          none
+ */
+static void work_run(void){
+  while(1){
+    drain_work();
+    set_isr(ISR_OFF);
+    ISR_ENTER(ISR_SITE_WORK);
+    if(workTail == workHead && !tickPending){ //Nothing was posted after the last item
+      break;
+    }
+    ISR_EXIT();
+    set_isr(ISR_ON);
+  }
+  kernelDraining = FALSE;
+  uppdateRunning();
+  ISR_EXIT();
+  LoadContext();
+}
+
+/** \brief  create the work context
+
+    This function is not available for the user to call.
+    Called by init_kernel, the TCB is kept out of all lists.
+
+    \param [in]      none
+    \return          FAIL/OK
+ */
+exception init_work(void){
+  if(workObj == NULL){
+    workObj = new_task(work_run, NO_DEADLINE);
+    if(workObj == NULL){
+      return FAIL;
+    }
+    workObj->pTask->pPart = NULL;
+    workObj->pTask->Policy = MISS_KERNEL;
+  }
+  return OK;
+}
+
+/** \brief  select the work context
+
+    This function is not available for the user to call.
+    Called by uppdateRunning with interrupts disabled. While work is
+    pending the work context runs before any task, it is started
+    from the top of its stack.
+
+    \param [in]      none
+    \return          the work context, or NULL when there is no work
+ */
+TCB *work_context(void){
+  TCB *pTask;
+  if(workObj == NULL){
+    return NULL;
+  }
+  pTask = workObj->pTask;
+  if(kernelDraining){ //Keep running until the queue is empty
+    return pTask;
+  }
+  if(workTail == workHead && !tickPending){
+    return NULL;
+  }
+  kernelDraining = TRUE;
+  pTask->PC = work_run;
+  pTask->SP = &(pTask->StackSeg[STACK_SIZE-1]);
+  pTask->SPSR = 0;
+  return pTask;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file DeferredWork.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the deferred interrupt work queue.
+ *
+ * Interrupt handlers post small work items here in O(1) and the kernel
+ * runs them at the next scheduling point. The items run at task level
+ * with interrupts enabled, on the stack of the work context: a TCB of
+ * its own that is switched in before any task while work is pending,
+ * so an interrupt during the drain saves its registers there and never
+ * into the context of a task.
+ */
+
+#ifndef Work_H
+#define Work_H
+#include "kernel.h"
+
+#define WORK_QUEUE_SIZE 16      /**< number of work items, must be a power of two. */
+
+typedef void (*workfn)(void *pArg);
+
+// Deferred work item
+typedef struct {
+  workfn        pFunc;
+  void          *pArg;
+} workitem;
+
+exception post_work(workfn pFunc, void *pArg);
+void post_tick(void);
+uint pending_work(void);
+void drain_work(void);
+exception init_work(void);
+TCB *work_context(void);
+
+#endif
@@ -0,0 +1,241 @@
+/**************************************************************************//**
+ * @file     HeapStats.c
+ * @brief    ART Real Time Micro Kernel HeapStats.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Heap usage profiler
+******************************************************************************/
+
+#include <stdint.h>
+#include "HeapStats.h"
+#include "TaskAdministration.h"
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+// A live object, found by its address with linear probing
+typedef struct {
+  void          *pObj;          // NULL marks a free slot
+  const void    *pOwner;
+  uint          nSize;
+  int           nSite;          // -1 when the site table was full
+  kobj_type     Type;
+} heap_obj;
+
+static heap_stats heapStats;            /**< collected statistics. */
+static heap_obj heapLive[HEAP_LIVE];    /**< live objects. */
+
+#define HEAP_HASH(p)    ((uint)(((uintptr_t)(p)) >> 3) & (HEAP_LIVE-1))
+
+/** \brief  account bytes taken or given back
+
+    \param [in]      pCount: the counters
+    \param [in]      nSize: the bytes
+    \param [in]      bAlloc: TRUE for an allocation
+    \return          none
+ */
+static void heap_count_add(heap_count *pCount, uint nSize, uint bAlloc){
+  if(bAlloc){
+    pCount->nAllocs++;
+    pCount->nBytes += nSize;
+    if(pCount->nBytes > pCount->nPeak){
+      pCount->nPeak = pCount->nBytes;
+    }
+  }
+  else{
+    pCount->nFrees++;
+    pCount->nBytes -= nSize;
+  }
+}
+
+/** \brief  find or add a call site
+
+    \param [in]      pFile, nLine: the kmem_alloc call
+    \param [in]      type: the kind of object
+    \return          index in Site or -1 when the table is full
+ */
+static int heap_site_of(const char *pFile, uint nLine, kobj_type type){
+  uint i;
+  for(i = 0; i < heapStats.nSites; i++){
+    if(heapStats.Site[i].nLine == nLine && heapStats.Site[i].pFile == pFile){
+      return i;
+    }
+  }
+  if(heapStats.nSites == HEAP_SITES){
+    return -1;
+  }
+  heapStats.Site[i].pFile = pFile;
+  heapStats.Site[i].nLine = nLine;
+  heapStats.Site[i].Type = type;
+  heapStats.nSites++;
+  return i;
+}
+
+/** \brief  find a live object
+
+    \param [in]      pObj: the object
+    \return          index in heapLive or -1
+ */
+static int heap_find(void *pObj){
+  uint i = HEAP_HASH(pObj);
+  uint n;
+  for(n = 0; n < HEAP_LIVE && heapLive[i].pObj != NULL; n++){
+    if(heapLive[i].pObj == pObj){
+      return i;
+    }
+    i = (i + 1) & (HEAP_LIVE-1);
+  }
+  return -1;
+}
+
+/** \brief  remove a live object
+
+    Moves the objects probed past the freed slot back, so every object
+    stays reachable from its hash slot without tombstones.
+
+    \param [in]      i: index in heapLive
+    \return          none
+ */
+static void heap_unlink(uint i){
+  uint j = i;
+  heapLive[i].pObj = NULL;
+  for(;;){
+    uint k;
+    j = (j + 1) & (HEAP_LIVE-1);
+    if(heapLive[j].pObj == NULL){
+      return;
+    }
+    k = HEAP_HASH(heapLive[j].pObj);
+    if(i <= j ? (i < k && k <= j) : (i < k || k <= j)){
+      continue; //Still reachable from its hash slot
+    }
+    heapLive[i] = heapLive[j];
+    heapLive[j].pObj = NULL;
+    i = j;
+  }
+}
+
+/** \brief  account an allocation
+
+    Called by kmem_alloc for every object handed out. The object is
+    owned by the running task, or by no one before run().
+
+    \param [in]      pObj: the object
+    \param [in]      type: the kind of object
+    \param [in]      size: the bytes taken, with the size class or pool object size
+    \param [in]      pFile, nLine: the kmem_alloc call
+    \return          none
+ */
+void heap_stat_alloc(void *pObj, kobj_type type, uint size, const char *pFile, uint nLine){
+  int x = KMEM_LOCK();
+  uint i = HEAP_HASH(pObj);
+  uint n;
+  int nSite = heap_site_of(pFile, nLine, type);
+  for(n = 0; n < HEAP_LIVE && heapLive[i].pObj != NULL; n++){
+    i = (i + 1) & (HEAP_LIVE-1);
+  }
+  if(n == HEAP_LIVE){
+    heapStats.nUntracked++; //Not accounted, its free is ignored as well
+    KMEM_UNLOCK(x);
+    return;
+  }
+  heapLive[i].pObj = pObj;
+  heapLive[i].pOwner = kernelMode == RUNNING ? Running : NULL;
+  heapLive[i].nSize = size;
+  heapLive[i].nSite = nSite;
+  heapLive[i].Type = type;
+  if(nSite >= 0){
+    heap_count_add(&heapStats.Site[nSite].Count, size, TRUE);
+  }
+  heap_count_add(&heapStats.Type[type], size, TRUE);
+  heap_count_add(&heapStats.Total, size, TRUE);
+  KMEM_UNLOCK(x);
+}
+
+/** \brief  account a free
+
+    \param [in]      pObj: the object given to kmem_free
+    \return          none
+ */
+void heap_stat_free(void *pObj){
+  int x = KMEM_LOCK();
+  int i = heap_find(pObj);
+  if(i >= 0){
+    heap_obj *pLive = &heapLive[i];
+    if(pLive->nSite >= 0){
+      heap_count_add(&heapStats.Site[pLive->nSite].Count, pLive->nSize, FALSE);
+    }
+    heap_count_add(&heapStats.Type[pLive->Type], pLive->nSize, FALSE);
+    heap_count_add(&heapStats.Total, pLive->nSize, FALSE);
+    heap_unlink(i);
+  }
+  KMEM_UNLOCK(x);
+}
+
+/** \brief  hand an object to another owner
+
+    \param [in]      pObj: the object
+    \param [in]      pOwner: the Mailbox or TCB now responsible for it
+    \return          none
+ */
+void heap_stat_owner(void *pObj, const void *pOwner){
+  int x = KMEM_LOCK();
+  int i = heap_find(pObj);
+  if(i >= 0){
+    heapLive[i].pOwner = pOwner;
+  }
+  KMEM_UNLOCK(x);
+}
+
+/** \brief  report the objects an owner left behind
+
+    Called when a Mailbox is removed or a task terminates, after its
+    own objects were freed. The objects it still owns are summed up in
+    a leak report and left without an owner, so a Mailbox or TCB later
+    allocated at the same address is not charged for them.
+
+    \param [in]      pOwner: the Mailbox or TCB
+    \return          number of objects left behind
+ */
+uint heap_stat_leaks(const void *pOwner){
+  int x = KMEM_LOCK();
+  heap_leak leak = { pOwner, 0, 0, -1 };
+  uint i;
+  for(i = 0; i < HEAP_LIVE; i++){
+    if(heapLive[i].pObj != NULL && heapLive[i].pOwner == pOwner){
+      leak.nObjects++;
+      leak.nBytes += heapLive[i].nSize;
+      leak.nSite = heapLive[i].nSite;
+      heapLive[i].pOwner = NULL;
+    }
+  }
+  if(leak.nObjects > 0){
+    heapStats.Leak[heapStats.nLeaks % HEAP_LEAKS] = leak;
+    heapStats.nLeaks++;
+  }
+  KMEM_UNLOCK(x);
+  return leak.nObjects;
+}
+
+/** \brief  return the collected statistics
+
+    \param [in]      none
+    \return          pointer to the statistics
+ */
+const heap_stats *heap_stats_get(void){
+  return &heapStats;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file HeapStats.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the kernel heap usage profiler.
+ *
+ * Compiled in when KERNEL_HEAP_STATS is defined in kernel.h. Every
+ * kmem_alloc/kmem_free is then accounted per call site (the file and
+ * line of the kmem_alloc) and per object type, with current and peak
+ * bytes. The bytes are those taken from the allocator, the whole size
+ * class of a data buffer and the pool object size in the static
+ * configuration, not the size asked for. Each live object also has an
+ * owner, the task that allocated it or the Mailbox holding it. Objects
+ * that have their own remove call (lists, tasks, Mailboxes, topics,
+ * subscribers, streams, kernel instances) own themselves and the parts
+ * that go with them, so they are not charged to the task that created
+ * them. remove_mailbox, terminate and an aborted job report the
+ * objects their Mailbox or task still owns as a leak once the Mailbox
+ * or task is gone, and the objects are then left without an owner.
+ *
+ * Without KERNEL_HEAP_STATS the HEAP_ macros expand to nothing.
+ */
+
+#ifndef HeapStats_H
+#define HeapStats_H
+#include "kernel.h"
+#include "KernelMem.h"
+
+#define HEAP_SITES      32      /**< call sites accounted. */
+#define HEAP_LIVE       128     /**< live objects tracked, a power of two. */
+#define HEAP_LEAKS      8       /**< last leak reports kept. */
+
+// Usage counters of a call site, an object type or all objects
+typedef struct {
+  uint          nAllocs;
+  uint          nFrees;
+  uint          nBytes;         // bytes in use
+  uint          nPeak;          // largest nBytes seen
+} heap_count;
+
+// One kmem_alloc call site
+typedef struct {
+  const char    *pFile;
+  uint          nLine;
+  kobj_type     Type;
+  heap_count    Count;
+} heap_site;
+
+// Objects left behind by a removed Mailbox or terminated task
+typedef struct {
+  const void    *pOwner;        // the Mailbox or TCB
+  uint          nObjects;
+  uint          nBytes;
+  int           nSite;          // index in Site of one of the objects
+} heap_leak;
+
+// Heap usage statistics
+typedef struct {
+  heap_site     Site[HEAP_SITES];
+  uint          nSites;
+  heap_count    Type[KOBJ_TYPES];
+  heap_count    Total;
+  uint          nUntracked;     // allocations with no room in the tables
+  heap_leak     Leak[HEAP_LEAKS];       // ring of the last reports
+  uint          nLeaks;         // reports made in total
+} heap_stats;
+
+#ifdef KERNEL_HEAP_STATS
+#define HEAP_OWNER(pObj, pOwner)  heap_stat_owner((pObj), (pOwner))
+#define HEAP_LEAKS_OF(pOwner)     heap_stat_leaks(pOwner)
+#else
+#define HEAP_OWNER(pObj, pOwner)
+#define HEAP_LEAKS_OF(pOwner)
+#endif
+
+void heap_stat_alloc(void *pObj, kobj_type type, uint size, const char *pFile, uint nLine);
+void heap_stat_free(void *pObj);
+void heap_stat_owner(void *pObj, const void *pOwner);
+uint heap_stat_leaks(const void *pOwner);
+const heap_stats *heap_stats_get(void);
+
+#endif
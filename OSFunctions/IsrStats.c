@@ -0,0 +1,105 @@
+/**************************************************************************//**
+ * @file     IsrStats.c
+ * @brief    ART Real Time Micro Kernel IsrStats.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Interrupts-disabled time instrumentation
+******************************************************************************/
+
+#include <string.h>
+#include "IsrStats.h"
+#include "../kernel_hwdep.h"
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+static isr_stats isrStats;      /**< collected statistics. */
+static uint     isrEnterStamp;  /**< time stamp of the open critical section. */
+static isr_site isrSite;        /**< call site of the outermost open critical section. */
+static uint     isrDepth;       /**< number of open critical sections. */
+
+/** \brief  mark critical section entry
+
+    Called right after interrupts have been disabled. Sections nest,
+    one entered while another is open (a kernel function called with
+    interrupts off) is part of the outer one and is not measured on
+    its own.
+
+    \param [in]      site: the kernel call that disabled interrupts
+    \return          none
+ */
+void isr_stat_enter(isr_site site){
+  if(isrDepth++ == 0){
+    isrSite = site;
+    isrEnterStamp = timer0_stamp();
+  }
+}
+
+/** \brief  mark critical section exit
+
+    Called right before interrupts are enabled again, or before
+    LoadContext() hands over to the next task. The section is
+    measured when the outermost one is closed. An exit without an
+    open section, the resumed half of a call whose section was
+    closed by dispatch(), is ignored.
+
+    \param [in]      none
+    \return          none
+ */
+void isr_stat_exit(void){
+  uint nTime = timer0_stamp() - isrEnterStamp;
+  uint nBucket = 0;
+  if(isrDepth == 0 || --isrDepth != 0){
+    return;
+  }
+  isrStats.Site[isrSite].nCount++;
+  isrStats.Site[isrSite].nTotal += nTime;
+  if(nTime > isrStats.Site[isrSite].nMax){
+    isrStats.Site[isrSite].nMax = nTime;
+  }
+  if(nTime > isrStats.nMax){
+    isrStats.nMax = nTime;
+    isrStats.WorstSite = isrSite;
+  }
+  while((nTime >>= 1) != 0 && nBucket < ISR_HIST_BUCKETS-1){
+    nBucket++;
+  }
+  isrStats.Hist[nBucket]++;
+}
+
+/** \brief  return the collected statistics
+
+    The statistics may be read at any time, a consistent copy is
+    made by the caller with interrupts disabled if needed.
+
+    \param [in]      none
+    \return          pointer to the statistics
+ */
+const isr_stats *isr_stats_get(void){
+  return &isrStats;
+}
+
+/** \brief  clear the collected statistics
+
+    \param [in]      none
+    \return          none
+ */
+void isr_stats_reset(void){
+  uint x = set_isr(ISR_OFF);
+  memset(&isrStats, 0, sizeof(isrStats));
+  set_isr(x);
+}
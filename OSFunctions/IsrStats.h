@@ -0,0 +1,90 @@
+/**
+ * @file IsrStats.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the interrupts-disabled time instrumentation.
+ *
+ * Compiled in when KERNEL_ISR_STATS is defined in kernel.h, otherwise the
+ * ISR_ENTER/ISR_EXIT macros expand to nothing.
+ *
+ * Every section of the kernel that disables interrupts is marked, the
+ * default KMEM_LOCK included. Sections nest and are measured from the
+ * outermost ENTER to its EXIT, so nMax is the longest time interrupts
+ * were off in the kernel.
+ */
+
+#ifndef IsrStats_H
+#define IsrStats_H
+#include "kernel.h"
+
+#define ISR_HIST_BUCKETS 16     /**< bucket i holds durations in [2^i, 2^(i+1)) counts. */
+
+// Critical section call sites
+typedef enum {
+  ISR_SITE_CREATE_TASK,
+  ISR_SITE_TERMINATE,
+  ISR_SITE_DISPATCH,
+  ISR_SITE_SEND_WAIT,
+  ISR_SITE_RECEIVE_WAIT,
+  ISR_SITE_SEND_NO_WAIT,
+  ISR_SITE_RECEIVE_NO_WAIT,
+  ISR_SITE_WAIT,
+  ISR_SITE_SET_DEADLINE,
+  ISR_SITE_TIMER_INT,
+  ISR_SITE_IDLE,
+  ISR_SITE_PUBLISH,
+  ISR_SITE_TAKE,
+  ISR_SITE_LITE,
+  ISR_SITE_CALL,
+  ISR_SITE_CYCLIC,
+  ISR_SITE_STREAM,
+  ISR_SITE_TIMER,
+  ISR_SITE_TICK_WORK,
+  ISR_SITE_WORK,
+  ISR_SITE_KMEM,
+  ISR_SITE_CPU_STATS,
+  ISR_SITE_MSG_STATS,
+  ISR_SITE_PC_SAMPLE,
+  ISR_SITE_TOPIC,
+  ISR_SITE_OVERLOAD,
+  ISR_SITE_MAILBOX,
+  ISR_SITES
+} isr_site;
+
+// Interrupts-disabled statistics for one call site
+typedef struct {
+  uint          nCount;
+  uint          nMax;
+  uint          nTotal;
+} isr_sitestat;
+
+// Interrupts-disabled statistics, durations in timer0_stamp() units
+typedef struct {
+  isr_sitestat  Site[ISR_SITES];
+  uint          Hist[ISR_HIST_BUCKETS];
+  uint          nMax;
+  isr_site      WorstSite;
+} isr_stats;
+
+#ifdef KERNEL_ISR_STATS
+#define ISR_ENTER(site)  isr_stat_enter(site)
+#define ISR_EXIT()       isr_stat_exit()
+#else
+#define ISR_ENTER(site)
+#define ISR_EXIT()
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void isr_stat_enter(isr_site site);
+void isr_stat_exit(void);
+const isr_stats *isr_stats_get(void);
+void isr_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,110 @@
+/**
+ * @file KernelCtx.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the state of one kernel instance.
+ *
+ * The lists, Running, TC, the time base, the work queue, the state of
+ * the lite runner, the cyclic schedule and the partitions of a kernel
+ * are kept in a kernel_ctx. The kernel
+ * reaches the current one through pKernel, which is kernelDefault
+ * unless select_kernel was called. The names below read and write the
+ * fields of the current instance, so the kernel code does not change.
+ *
+ * A host build running one kernel per thread defines KERNEL_TLS as its
+ * thread-local storage class (e.g. __thread), then each thread calls
+ * select_kernel(create_kernel()) before init_kernel. context.s79 reads
+ * Running through pKernel, Running must stay the first field.
+ *
+ * The object allocator and HeapStats are shared by all instances and
+ * serialized by KMEM_LOCK, see KernelMem.h. Freed objects of any
+ * instance may be given back by the idle task of any other. IsrStats
+ * is shared as well and only meant for one kernel.
+ *
+ * This tree has SaveContext/LoadContext for the ARM target only
+ * (context.s79). A host build needs its own pair for the tasks of a
+ * thread before kernels can run on several threads, until then the
+ * instances are for one CPU, selected one at a time.
+ */
+
+#ifndef KernelCtx_H
+#define KernelCtx_H
+#include "kernel.h"
+#include "DeferredWork.h"
+
+#ifndef KERNEL_TLS
+#define KERNEL_TLS
+#endif
+
+// State of one kernel
+struct kernel_ctx {
+  TCB           *Running;       // first field, see context.s79
+  list          *timmerL;
+  list          *waitingL;
+  list          *readyL;
+  uint          kernelMode;
+  uint          TC;
+  // TimerFunctions.c
+  volatile utime timeBase;
+  volatile uint timerInterval;
+  utime         nextTick;
+  uint          sliceTicks;
+  uint          sliceStart;
+  TCB           *sliceTask;
+  listobj       *timerObj;      // timer service task, NULL before init_timer
+  swtimer       *timerFirst;
+  swtimer       *timerLast;
+  // DeferredWork.c
+  workitem      workQueue[WORK_QUEUE_SIZE];
+  volatile uint workHead;
+  volatile uint workTail;
+  volatile uint tickPending;    // the tick work is due, it takes no queue slot
+  volatile uint kernelDraining; // the work context is running
+  listobj       *workObj;
+  // Lite.c
+  lite          *liteReady;
+  lite          *liteRunning;
+  lite          *litePoll;
+  listobj       *runnerObj;
+  // CpuStats.c
+  utime         cpuStamp;
+  // Overload.c
+  uint          missCount[MISS_POLICIES];
+  // Cyclic.c
+  TCB           *cyclicJob;     // executive task while a slot body runs
+  const cyclic_table *pCyclic;
+  listobj       *cyclicObj;
+  uint          cyclicTick;
+  uint          cyclicMinor;
+  uint          cyclicSlot;
+  uint          cyclicNext;
+  uint          cyclicPending;
+  uint          cyclicOverruns;
+  uint          cyclicSkipped;
+  // Partition.c
+  list          *readyMain;     // Readylist of the tasks outside of all partitions
+  partition     *partFirst;
+  partition     *partNew;       // partition of tasks created in start up mode
+  partition     *partCharge;
+  uint          partFrame;
+  uint          partTick;
+};
+
+extern KERNEL_TLS kernel_ctx *pKernel;  /**< the kernel instance of the caller. */
+
+#define Running         (pKernel->Running)
+#define timmerL         (pKernel->timmerL)
+#define waitingL        (pKernel->waitingL)
+#define readyL          (pKernel->readyL)
+#define kernelMode      (pKernel->kernelMode)
+#define TC              (pKernel->TC)
+#define kernelDraining  (pKernel->kernelDraining)
+#define cyclicJob       (pKernel->cyclicJob)
+#define readyMain       (pKernel->readyMain)
+#define partFirst       (pKernel->partFirst)
+#define partNew         (pKernel->partNew)
+
+// Readylist a task is inserted in when it is made ready
+#define READY_LIST(pTask) ((pTask)->pPart != NULL ? (pTask)->pPart->pReady : readyMain)
+
+#endif
@@ -0,0 +1,385 @@
+/**************************************************************************//**
+ * @file     KernelMem.c
+ * @brief    ART Real Time Micro Kernel KernelMem.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Kernel object allocation
+******************************************************************************/
+
+#include <string.h>
+#include "KernelMem.h"
+#include "Topic.h"
+#include "Stream.h"
+#include "HeapStats.h"
+#include "KernelCtx.h"
+#include "IsrStats.h"
+#include "../kernel_hwdep.h"
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+int mymem_count_alloc;  /**< define mymem_count_alloc Variable to see allocated memory . */ 
+int mymem_count_free;   /**< define mymem_count_free Variable to see free memory . */ 
+
+// Message data size classes, smallest first
+static const uint dataClass[DATA_CLASSES] = { 16, 64, 256, 1024 };
+
+// Header in front of a data buffer holding its class, as large as the
+// strictest alignment of a Message so the data behind it is aligned
+typedef union {
+  uint          nClass;
+  utime         nAlign;
+  void          *pAlign;
+} dataheader;
+
+#ifdef KERNEL_STATIC
+
+// Fixed size object pool
+typedef struct {
+  char          *pBase;         // First object
+  uint          nSize;          // Object size
+  uint          nCount;         // Number of objects
+  uint          nNext;          // Objects never handed out start here
+  void          *pFree;         // Freed objects, linked through their first word
+} kpool;
+
+// Headers of a data pool, each buffer starts with a header holding its class
+#define DATA_WORDS(n, size)     ((n) * (1 + (size)/sizeof(dataheader)))
+#define DATA_16_BASE            0
+#define DATA_64_BASE            (DATA_16_BASE + DATA_WORDS(CFG_DATA_16, 16))
+#define DATA_256_BASE           (DATA_64_BASE + DATA_WORDS(CFG_DATA_64, 64))
+#define DATA_1024_BASE          (DATA_256_BASE + DATA_WORDS(CFG_DATA_256, 256))
+#define DATA_POOL_WORDS         (DATA_1024_BASE + DATA_WORDS(CFG_DATA_1024, 1024))
+
+static list     listPool[CFG_MAX_LISTS + 1];
+static listobj  objPool[2*CFG_MAX_TASKS + 2*CFG_MAX_LISTS];     // tasks, timeouts and sentinels
+static TCB      tcbPool[CFG_MAX_TASKS];
+static mailbox  boxPool[CFG_MAX_MAILBOXES];
+static msg      msgPool[CFG_MAX_MSGS + 2*CFG_MAX_MAILBOXES];    // messages and sentinels
+static topic    topicPool[CFG_MAX_TOPICS];
+static subscriber subPool[CFG_MAX_SUBSCRIBERS];
+static kernel_ctx kernelPool[CFG_MAX_KERNELS + 1];
+static stream   streamPool[CFG_MAX_STREAMS + 1];
+static dataheader dataPool[DATA_POOL_WORDS + 1];
+
+static kpool pools[KOBJ_TYPES] = {
+  { (char *)listPool, sizeof(list),    CFG_MAX_LISTS, 0, NULL },
+  { (char *)objPool,  sizeof(listobj), sizeof(objPool)/sizeof(listobj), 0, NULL },
+  { (char *)tcbPool,  sizeof(TCB),     CFG_MAX_TASKS, 0, NULL },
+  { (char *)boxPool,  sizeof(mailbox), CFG_MAX_MAILBOXES, 0, NULL },
+  { (char *)msgPool,  sizeof(msg),     sizeof(msgPool)/sizeof(msg), 0, NULL },
+  { (char *)topicPool, sizeof(topic),  CFG_MAX_TOPICS, 0, NULL },
+  { (char *)subPool,  sizeof(subscriber), CFG_MAX_SUBSCRIBERS, 0, NULL },
+  { (char *)kernelPool, sizeof(kernel_ctx), CFG_MAX_KERNELS, 0, NULL },
+  { (char *)streamPool, sizeof(stream), CFG_MAX_STREAMS, 0, NULL },
+  { NULL, 0, 0, 0, NULL },                                      // see dataPools
+};
+
+static kpool dataPools[DATA_CLASSES] = {
+  { (char *)&dataPool[DATA_16_BASE],   sizeof(dataheader) + 16,   CFG_DATA_16, 0, NULL },
+  { (char *)&dataPool[DATA_64_BASE],   sizeof(dataheader) + 64,   CFG_DATA_64, 0, NULL },
+  { (char *)&dataPool[DATA_256_BASE],  sizeof(dataheader) + 256,  CFG_DATA_256, 0, NULL },
+  { (char *)&dataPool[DATA_1024_BASE], sizeof(dataheader) + 1024, CFG_DATA_1024, 0, NULL },
+};
+
+/** \brief  take an object from a pool
+
+    \param [in]      pPool: the pool
+    \return          pointer to the object or NULL when the pool is empty
+ */
+static void *pool_alloc(kpool *pPool){
+  void *pObj;
+  if(pPool->pFree != NULL){
+    pObj = pPool->pFree;
+    pPool->pFree = *(void **)pObj;
+  }
+  else if(pPool->nNext < pPool->nCount){
+    pObj = pPool->pBase + pPool->nNext * pPool->nSize;
+    pPool->nNext++;
+  }
+  else{
+    return NULL;
+  }
+  return pObj;
+}
+
+/** \brief  give an object back to its pool
+
+    \param [in]      pPool: the pool the object was taken from
+    \param [in]      pObj: the object
+    \return          none
+ */
+static void pool_free(kpool *pPool, void *pObj){
+  *(void **)pObj = pPool->pFree;
+  pPool->pFree = pObj;
+}
+
+#else
+
+static void     *dataFree[DATA_CLASSES];        // Freed buffers, linked through their first word
+static void     *reclaimList;                   // Freed objects not yet given back to the heap
+
+/** \brief  give an object back to the heap later
+
+    Queues the object in O(1), it is freed by kmem_reclaim() in the
+    idle task so free() is not run on the critical path. Called with
+    KMEM_LOCK taken.
+
+    \param [in]      pObj: the object as returned by malloc
+    \return          none
+ */
+static void heap_free(void *pObj){
+  *(void **)pObj = reclaimList;
+  reclaimList = pObj;
+}
+
+#endif
+
+/** \brief  take the allocator lock
+
+    The default KMEM_LOCK, interrupts are disabled.
+
+    \param [in]      none
+    \return          the interrupt state for kmem_unlock
+ */
+int kmem_lock(void){
+  int x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_KMEM);
+  return x;
+}
+
+/** \brief  release the allocator lock
+
+    \param [in]      nLock: the value returned by kmem_lock
+    \return          none
+ */
+void kmem_unlock(int nLock){
+  ISR_EXIT();
+  set_isr(nLock);
+}
+
+/** \brief  allocate a Message data buffer
+
+    The buffer is taken from the smallest size class that fits and is
+    not cleared, only the length of the Message is written to it. The
+    header in front of the buffer holds its class and keeps the buffer
+    aligned for any type. On the heap a buffer larger than the largest
+    class gets the class DATA_CLASSES.
+
+    \param [in]      size: the length of the data in bytes
+    \return          pointer to the data or NULL
+ */
+static void *data_alloc(uint size){
+  uint nClass = 0;
+  dataheader *pBuf;
+  while(nClass < DATA_CLASSES && size > dataClass[nClass]){
+    nClass++;
+  }
+#ifdef KERNEL_STATIC
+  pBuf = NULL;
+  for(; nClass < DATA_CLASSES && pBuf == NULL; nClass++){ //a larger class when one is used up
+    pBuf = (dataheader *)pool_alloc(&dataPools[nClass]);
+  }
+  if(pBuf == NULL){
+    return NULL;
+  }
+  nClass--;
+#else
+  if(nClass < DATA_CLASSES && dataFree[nClass] != NULL){
+    pBuf = (dataheader *)dataFree[nClass];
+    dataFree[nClass] = *(void **)pBuf;
+  }
+  else{
+    pBuf = (dataheader *)malloc(sizeof(dataheader) + (nClass < DATA_CLASSES ? dataClass[nClass] : size));
+    if(pBuf == NULL){
+      return NULL;
+    }
+  }
+#endif
+  pBuf[0].nClass = nClass;
+  return &pBuf[1];
+}
+
+/** \brief  free a Message data buffer
+
+    \param [in]      pData: the data as returned by data_alloc
+    \return          none
+ */
+static void data_free(void *pData){
+  dataheader *pBuf = (dataheader *)pData - 1;
+  uint nClass = pBuf[0].nClass;
+#ifdef KERNEL_STATIC
+  pool_free(&dataPools[nClass], pBuf);
+#else
+  if(nClass == DATA_CLASSES){
+    heap_free(pBuf);
+    return;
+  }
+  *(void **)pBuf = dataFree[nClass];
+  dataFree[nClass] = pBuf;
+#endif
+}
+
+/** \brief  allocate a kernel object
+
+    Returns a zeroed object, except Message data which is taken from
+    its size class by data_alloc. In the static configuration the object
+    is taken from the pool of its type, a request larger than the
+    pool objects fails. The pools are not initialized at start up,
+    objects that were never used are handed out in order.
+
+    \param [in]      type: the kind of object
+    \param [in]      size: the size of the object in bytes
+    \return          pointer to the object or NULL
+ */
+static void *kmem_take(kobj_type type, uint size){
+  void *pObj;
+  int x = KMEM_LOCK();
+  if(type == KOBJ_DATA){
+    pObj = data_alloc(size);
+  }
+  else{
+#ifdef KERNEL_STATIC
+    kpool *pPool = &pools[type];
+    pObj = size <= pPool->nSize ? pool_alloc(pPool) : NULL;
+    if(pObj != NULL){
+      memset(pObj, 0, pPool->nSize);
+    }
+#else
+    pObj = calloc(1, size);
+#endif
+  }
+  if(pObj != NULL){
+    mymem_count_alloc++;
+  }
+  KMEM_UNLOCK(x);
+  return pObj;
+}
+
+#ifdef KERNEL_HEAP_STATS
+/** \brief  bytes an allocation took
+
+    A data buffer takes its whole size class and header, a pool object
+    the size of its pool.
+
+    \param [in]      type: the kind of object
+    \param [in]      pObj: the object as returned by kmem_take
+    \param [in]      size: the size asked for
+    \return          the bytes taken
+ */
+static uint kmem_taken(kobj_type type, void *pObj, uint size){
+  if(type == KOBJ_DATA){
+    uint nClass = ((dataheader *)pObj - 1)[0].nClass;
+    return sizeof(dataheader) + (nClass < DATA_CLASSES ? dataClass[nClass] : size);
+  }
+#ifdef KERNEL_STATIC
+  return pools[type].nSize;
+#else
+  return size;
+#endif
+}
+
+/** \brief  allocate a kernel object and account it
+
+    \param [in]      type: the kind of object
+    \param [in]      size: the size of the object in bytes
+    \param [in]      pFile, nLine: the call site
+    \return          pointer to the object or NULL
+ */
+void *kmem_alloc_at(kobj_type type, uint size, const char *pFile, uint nLine){
+  void *pObj = kmem_take(type, size);
+  if(pObj != NULL){
+    heap_stat_alloc(pObj, type, kmem_taken(type, pObj, size), pFile, nLine);
+  }
+  return pObj;
+}
+#else
+/** \brief  allocate a kernel object, see kmem_take
+
+    \param [in]      type: the kind of object
+    \param [in]      size: the size of the object in bytes
+    \return          pointer to the object or NULL
+ */
+void *kmem_alloc(kobj_type type, uint size){
+  return kmem_take(type, size);
+}
+#endif
+
+/** \brief  free a kernel object
+
+    \param [in]      type: the kind of object, as given to kmem_alloc
+    \param [in]      pObj: the object, NULL is ignored
+    \return          none
+ */
+void kmem_free(kobj_type type, void *pObj){
+  int x;
+  if(pObj == NULL){
+    return;
+  }
+#ifdef KERNEL_HEAP_STATS
+  heap_stat_free(pObj);
+#endif
+  x = KMEM_LOCK();
+  if(type == KOBJ_DATA){
+    data_free(pObj);
+  }
+  else{
+#ifdef KERNEL_STATIC
+    pool_free(&pools[type], pObj);
+#else
+    heap_free(pObj);
+#endif
+  }
+  mymem_count_free++;
+  KMEM_UNLOCK(x);
+}
+
+/** \brief  give one freed object back to the heap
+
+    Called by the idle task of every kernel instance. Objects are freed
+    one at a time under KMEM_LOCK, so the heap is never entered twice. In the
+    static configuration objects go back to their pool at once and
+    there is nothing to do.
+
+    \param [in]      none
+    \return          TRUE if an object was freed
+ */
+uint kmem_reclaim(void){
+#ifdef KERNEL_STATIC
+  return FALSE;
+#else
+  void *pObj;
+  int x = KMEM_LOCK();
+  pObj = reclaimList;
+  if(pObj != NULL){
+    reclaimList = *(void **)pObj;
+    free(pObj);
+  }
+  KMEM_UNLOCK(x);
+  return pObj != NULL;
+#endif
+}
+
+/** \brief  give all freed objects back to the heap
+
+    \param [in]      none
+    \return          none
+ */
+void kmem_flush(void){
+  while(kmem_reclaim()){
+  }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file KernelMem.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the kernel object allocator.
+ *
+ * All kernel objects are allocated here. By default they come from the
+ * heap. With KERNEL_STATIC defined in kernel.h they come from pools in
+ * .bss sized by the CFG_ macros below, and the heap is never used.
+ *
+ * Message data is kept in buffers of the size classes 16, 64, 256 and
+ * 1024 bytes, a request gets a buffer of the smallest class that fits.
+ * On the heap freed buffers are kept for reuse in their class.
+ *
+ * On the heap kmem_free only queues the object, the idle task gives it
+ * back with kmem_reclaim() or kmem_flush() does it at once.
+ *
+ * mymem_count_alloc and mymem_count_free count every object handed out
+ * and given back, HeapStats.h has the bytes per call site and type.
+ *
+ * The allocator and HeapStats are shared by all kernel instances and
+ * serialized by KMEM_LOCK. By default it disables interrupts, which is
+ * enough for the kernels of one CPU. A host build that runs a kernel
+ * per thread defines KMEM_LOCK and KMEM_UNLOCK as a process wide mutex,
+ * taken without nesting.
+ */
+
+#ifndef KernelMem_H
+#define KernelMem_H
+#include "kernel.h"
+
+#ifndef KMEM_LOCK
+#define KMEM_LOCK()             kmem_lock()             /**< returns what KMEM_UNLOCK takes. */
+#define KMEM_UNLOCK(nLock)      kmem_unlock(nLock)
+#endif
+
+#ifndef CFG_MAX_TASKS
+#define CFG_MAX_TASKS           8       /**< tasks including Idle, the work context and the timer service. */
+#endif
+#ifndef CFG_MAX_MAILBOXES
+#define CFG_MAX_MAILBOXES       4       /**< mailboxes. */
+#endif
+#ifndef CFG_MAX_MSGS
+#define CFG_MAX_MSGS            16      /**< messages in all mailboxes together. */
+#endif
+#ifndef CFG_MAX_TOPICS
+#define CFG_MAX_TOPICS          2       /**< publish/subscribe topics. */
+#endif
+#ifndef CFG_MAX_SUBSCRIBERS
+#define CFG_MAX_SUBSCRIBERS     8       /**< subscriptions of all topics together. */
+#endif
+#ifndef CFG_DATA_16
+#define CFG_DATA_16             16      /**< 16 byte Message data buffers. */
+#endif
+#ifndef CFG_DATA_64
+#define CFG_DATA_64             4       /**< 64 byte Message data buffers. */
+#endif
+#ifndef CFG_DATA_256
+#define CFG_DATA_256            2       /**< 256 byte Message data buffers. */
+#endif
+#ifndef CFG_DATA_1024
+#define CFG_DATA_1024           0       /**< 1024 byte Message data buffers. */
+#endif
+#ifndef CFG_MAX_STREAMS
+#define CFG_MAX_STREAMS         0       /**< byte streams. */
+#endif
+#ifndef CFG_MAX_KERNELS
+#define CFG_MAX_KERNELS         0       /**< kernel instances besides the default one. */
+#endif
+#ifndef CFG_MAX_LISTS
+#define CFG_MAX_LISTS           0       /**< lists besides the kernel lists. */
+#endif
+
+#define DATA_CLASSES            4       /**< number of Message data size classes. */
+
+// Largest nDataSize of a mailbox in the static configuration
+#if CFG_DATA_1024 > 0
+#define CFG_MSG_DATA_SIZE       1024
+#elif CFG_DATA_256 > 0
+#define CFG_MSG_DATA_SIZE       256
+#elif CFG_DATA_64 > 0
+#define CFG_MSG_DATA_SIZE       64
+#else
+#define CFG_MSG_DATA_SIZE       16
+#endif
+
+// Kernel object types
+typedef enum {
+  KOBJ_LIST,
+  KOBJ_LISTOBJ,
+  KOBJ_TCB,
+  KOBJ_MAILBOX,
+  KOBJ_MSG,
+  KOBJ_TOPIC,
+  KOBJ_SUBSCRIBER,
+  KOBJ_KERNEL,
+  KOBJ_STREAM,
+  KOBJ_DATA,
+  KOBJ_TYPES
+} kobj_type;
+
+#ifdef KERNEL_HEAP_STATS
+// Allocations are accounted at the line of the call, see HeapStats.h
+#define kmem_alloc(type, size)  kmem_alloc_at((type), (size), __FILE__, __LINE__)
+void *kmem_alloc_at(kobj_type type, uint size, const char *pFile, uint nLine);
+#else
+void *kmem_alloc(kobj_type type, uint size);
+#endif
+void kmem_free(kobj_type type, void *pObj);
+uint kmem_reclaim(void);
+int kmem_lock(void);
+void kmem_unlock(int nLock);
+void kmem_flush(void);
+
+#endif
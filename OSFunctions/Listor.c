@@ -19,27 +19,24 @@
 
 list * create_list()
 {
-  list * mylist = (list *)calloc(1, sizeof(list));
+  list * mylist = (list *)kmem_alloc(KOBJ_LIST, sizeof(list));
   if (mylist == NULL) {
     return NULL;
   }
-  mymem_count_alloc++;
-  mylist->pHead = (listobj *)calloc(1, sizeof(listobj));
+  mylist->pHead = (listobj *)kmem_alloc(KOBJ_LISTOBJ, sizeof(listobj));
   if (mylist->pHead == NULL) {
-    free(mylist);
-    mymem_count_free++;  
+    kmem_free(KOBJ_LIST, mylist);
     return NULL;
   }
-  mymem_count_alloc++;
-  mylist->pTail = (listobj *)calloc(1, sizeof(listobj));
+  mylist->pTail = (listobj *)kmem_alloc(KOBJ_LISTOBJ, sizeof(listobj));
   if (mylist->pTail == NULL) {
-    free(mylist->pHead);
-    free(mylist);
-    mymem_count_free++;  
-    mymem_count_free++;  
+    kmem_free(KOBJ_LISTOBJ, mylist->pHead);
+    kmem_free(KOBJ_LIST, mylist);
     return NULL;
   }
-  mymem_count_alloc++;
+  HEAP_OWNER(mylist, mylist); //A list and its sentinels own themselves
+  HEAP_OWNER(mylist->pHead, mylist);
+  HEAP_OWNER(mylist->pTail, mylist);
   mylist->pHead->pPrevious = mylist->pHead;
   mylist->pHead->pNext = mylist->pTail;
   mylist->pTail->pPrevious = mylist->pHead;
@@ -49,9 +46,8 @@ list * create_list()
 
 listobj *create_listobj(int num)
 {
-  listobj * myobj = (listobj *)calloc(1, sizeof(listobj));
-  myobj->pTask 	= (TCB *)calloc(1, sizeof(TCB));
-  if (myobj == NULL || myobj->pTask ==NULL)
+  listobj * myobj = create_listobjRL(0);
+  if (myobj == NULL)
   {
     return NULL;
   }
@@ -59,24 +55,46 @@ listobj *create_listobj(int num)
   return (myobj);
 }
 
+//Timerlist entry that is not a task, e.g. the timeout of a timed wait
+listobj *create_listobjTL()
+{
+  return (listobj *)kmem_alloc(KOBJ_LISTOBJ, sizeof(listobj));
+}
+
 listobj *create_listobjRL(int num)
 {
-  listobj * myobj = (listobj *)calloc(1, sizeof(listobj));//+1
-  myobj->pTask = (TCB *)calloc(1, sizeof(TCB));//+1
-  if (myobj == NULL || myobj->pTask ==NULL)
+  listobj * myobj = (listobj *)kmem_alloc(KOBJ_LISTOBJ, sizeof(listobj));
+  if (myobj == NULL)
+  {
+    return NULL;
+  }
+  myobj->pTask = (TCB *)kmem_alloc(KOBJ_TCB, sizeof(TCB));
+  if (myobj->pTask == NULL)
   {
+    kmem_free(KOBJ_LISTOBJ, myobj);
     return NULL;
   }
+  HEAP_OWNER(myobj, myobj->pTask); //A task owns itself, not its creator
+  HEAP_OWNER(myobj->pTask, myobj->pTask);
   //myobj->nTCnt = num;
   myobj->pTask->DeadLine = num;
   return (myobj);
 }
+
+//Remove a task list item and its TCB
+void remove_listobj(listobj *obj)
+{
+  kmem_free(KOBJ_LISTOBJ, obj->pTimeout);
+  kmem_free(KOBJ_TCB, obj->pTask);
+  kmem_free(KOBJ_LISTOBJ, obj);
+}
+
 //The element with the lowest value of TCB-> Deadline is first placed first in the list
 void insertRL(list *list, listobj *obj) {
        
     listobj *templist = list->pHead;
     while (templist->pNext != list->pTail) {
-        if (templist->pNext->pTask->DeadLine > obj->pTask->DeadLine) {
+        if (DEADLINE_BEFORE(obj->pTask->DeadLine, templist->pNext->pTask->DeadLine)) {
             break;
         }
         templist = templist->pNext;
@@ -107,7 +125,7 @@ void insertTL(list *list, listobj *obj) {
   // insert first in list 
   listobj *pTimertemp = list->pHead;
     while (pTimertemp->pNext != list->pTail) {
-        if ((pTimertemp->pNext->nTCnt > obj->nTCnt)) {
+        if ((pTimertemp->pNext->nWake > obj->nWake)) {
             break;
         }
         pTimertemp = pTimertemp->pNext;
@@ -120,53 +138,38 @@ void insertTL(list *list, listobj *obj) {
 }
 
 //Extraction made by the use of a pointer to the list element, struct l_obj * pBlock
+//The element must be in the list, it is unlinked directly without searching.
 listobj *extractWL(list *list, struct l_obj * pBlock ){
-    int found = 0;
-    listobj *obj_founded;
-    //listobj *obj = list->pHead->pNext;
-    listobj *ptemplist = list->pHead;
-    while((ptemplist->pNext != list->pTail) && (found!=1)){
-        ptemplist = ptemplist->pNext;
-        if(ptemplist == pBlock){
-            found = 1;
-            obj_founded = ptemplist;
-        } 
-    }
-    
-    if(found == 1){
-          pBlock->pPrevious->pNext = pBlock->pNext;
-          pBlock->pNext->pPrevious = pBlock->pPrevious;
-          pBlock->pNext = NULL;
-          pBlock->pPrevious = NULL;
-    }
-    return obj_founded;
+    (void)list; //The links of pBlock are enough to unlink it
+    pBlock->pPrevious->pNext = pBlock->pNext;
+    pBlock->pNext->pPrevious = pBlock->pPrevious;
+    pBlock->pNext = NULL;
+    pBlock->pPrevious = NULL;
+    return pBlock;
 }
 
 
 //MialBox fuctions
 mailbox* create_mailB()
 {
-  mailbox *mailb_list = (mailbox*)calloc(1,sizeof(mailbox));
+  mailbox *mailb_list = (mailbox*)kmem_alloc(KOBJ_MAILBOX, sizeof(mailbox));
   if (mailb_list == NULL) {
     return NULL;
   }
-  mymem_count_alloc++;
-  mailb_list->pHead = (msg*)calloc(1, sizeof(msg));
+  mailb_list->pHead = (msg*)kmem_alloc(KOBJ_MSG, sizeof(msg));
   if (mailb_list->pHead == NULL) {
-    free(mailb_list);
-    mymem_count_free++;  
+    kmem_free(KOBJ_MAILBOX, mailb_list);
     return NULL;
   }
-  mymem_count_alloc++;
-  mailb_list->pTail = (msg *)calloc(1, sizeof(msg));
+  mailb_list->pTail = (msg *)kmem_alloc(KOBJ_MSG, sizeof(msg));
   if (mailb_list->pTail == NULL) {
-    free(mailb_list->pHead);
-    mymem_count_free++; 
-    free(mailb_list);
-    mymem_count_free++; 
+    kmem_free(KOBJ_MSG, mailb_list->pHead);
+    kmem_free(KOBJ_MAILBOX, mailb_list);
     return NULL;
   }
-  mymem_count_alloc++;
+  HEAP_OWNER(mailb_list, mailb_list); //The Mailbox is not a leak of its creator
+  HEAP_OWNER(mailb_list->pHead, mailb_list); //The sentinels go with the Mailbox
+  HEAP_OWNER(mailb_list->pTail, mailb_list);
   mailb_list->pHead->pPrevious = mailb_list->pHead;
   mailb_list->pHead->pNext = mailb_list->pTail;
   mailb_list->pTail->pPrevious = mailb_list->pHead;
@@ -174,6 +177,14 @@ mailbox* create_mailB()
   return mailb_list;
 }
 
+//Remove an empty mailbox and its sentinels
+void remove_mailB(mailbox *mBox)
+{
+  kmem_free(KOBJ_MSG, mBox->pHead);
+  kmem_free(KOBJ_MSG, mBox->pTail);
+  kmem_free(KOBJ_MAILBOX, mBox);
+}
+
 
 void insertMB(mailbox *list, msg *obj){
 
@@ -188,15 +199,14 @@ void insertMB(mailbox *list, msg *obj){
 }
 
 //MSG
+//pBlock is set by the caller, to the blocked task or NULL for send_no_wait
 msg * createMsg(){ 
-  msg *msg_Obj = (msg*)calloc(1,sizeof(msg));
-  msg_Obj->pBlock = (listobj*)calloc(1,sizeof(listobj));
-  if (msg_Obj== NULL || msg_Obj->pBlock==NULL) {
-    return FAIL;
-  }
-  mymem_count_alloc++;
-  mymem_count_alloc++;
-  return msg_Obj;
+  return (msg*)kmem_alloc(KOBJ_MSG, sizeof(msg));
+}
+
+//Data area owned by a send_no_wait Message
+char * createMsgData(int size){
+  return (char*)kmem_alloc(KOBJ_DATA, size);
 }
 
 /** \brief  Remove receiving tasks Message
@@ -210,10 +220,7 @@ void remove_MBoxmsg(msg *nMsg){
   nMsg->pPrevious->pNext = nMsg->pNext;
   nMsg->pNext->pPrevious = nMsg->pPrevious;
   nMsg->pNext=nMsg->pPrevious=NULL;
-  free(nMsg->pBlock);
-  mymem_count_free++;
-  free(nMsg);
-  mymem_count_free++; 
+  kmem_free(KOBJ_MSG, nMsg); //pBlock is the task, it is not freed
 }
 
 void remove_msgRL(list * RL){
@@ -223,11 +230,8 @@ void remove_msgRL(list * RL){
     RL->pHead->pNext->pMessage->pNext = NULL;
     RL->pHead->pNext->pMessage->pPrevious = NULL;
     RL->pHead->pNext->pMessage->pBlock = NULL;
-    free(RL->pHead->pNext->pMessage->pData);
-    free(RL->pHead->pNext->pMessage->pBlock);
-    mymem_count_free++;
-    free(RL->pHead->pNext->pMessage);
-    mymem_count_free++;
+    //pData is the data area of the blocked task, it is not freed
+    kmem_free(KOBJ_MSG, RL->pHead->pNext->pMessage);
     RL->pHead->pNext->pMessage = NULL;
   //free(nMsg);
 }
@@ -246,26 +250,58 @@ void remove_OldMsg(mailbox *mBox){
   mBox->pTail->pPrevious = mBox->pTail->pPrevious->pPrevious;
   mBox->pTail->pPrevious->pNext= mBox->pTail->pPrevious->pNext->pNext;
   msg_Obj->pNext = msg_Obj->pPrevious=NULL;
-  free(msg_Obj->pBlock);
-  mymem_count_free++;
-  free(msg_Obj);
-  mymem_count_free++;
+  kmem_free(KOBJ_DATA, msg_Obj->pData); //Only send_no_wait Messages are removed
+  kmem_free(KOBJ_MSG, msg_Obj);
+}
+
+
+//Senders waiting for room are sorted by deadline, equal deadlines in arrival order
+void insertRoom(mailbox *mBox, msg *obj){
+  msg *pPrev = NULL;
+  msg *pNext = mBox->pRoom;
+  while(pNext != NULL &&
+        !DEADLINE_BEFORE(obj->pBlock->pTask->DeadLine, pNext->pBlock->pTask->DeadLine)){
+    pPrev = pNext;
+    pNext = pNext->pNext;
+  }
+  obj->pPrevious = pPrev;
+  obj->pNext = pNext;
+  if(pNext != NULL){
+    pNext->pPrevious = obj;
+  }
+  if(pPrev != NULL){
+    pPrev->pNext = obj;
+  }
+  else{
+    mBox->pRoom = obj;
+  }
+}
+
+//Unlink a sender waiting for room in constant time
+void extractRoom(mailbox *mBox, msg *obj){
+  if(obj->pPrevious != NULL){
+    obj->pPrevious->pNext = obj->pNext;
+  }
+  else{
+    mBox->pRoom = obj->pNext;
+  }
+  if(obj->pNext != NULL){
+    obj->pNext->pPrevious = obj->pPrevious;
+  }
+  obj->pNext = obj->pPrevious = NULL;
 }
 
 
 void remove_list(list * xList){
-  if(xList->pHead->pNext->pNext != NULL)
+  if(xList->pHead->pNext != xList->pTail) //Only empty lists are removed
   {
       return;
   }
   else{
     xList->pTail->pPrevious = NULL;
     xList->pHead->pNext = NULL;
-    free(xList->pHead);
-    free(xList->pTail);
-    free(xList);
-    mymem_count_free++;  
-    mymem_count_free++;  
-    mymem_count_free++;  
+    kmem_free(KOBJ_LISTOBJ, xList->pHead);
+    kmem_free(KOBJ_LISTOBJ, xList->pTail);
+    kmem_free(KOBJ_LIST, xList);
   }
 }
\ No newline at end of file
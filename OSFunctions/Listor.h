@@ -10,26 +10,34 @@
 #ifndef Listor_H
 #define Listor_H
 #include "kernel.h"
+#include "KernelMem.h"
+#include "HeapStats.h"
 
 list *create_list();
 //TL + WT fuctions
 listobj *create_listobj(int num);
+listobj *create_listobjTL();
 void insertTL(list *list, listobj *obj);
 listobj *extractWL(list *list, struct l_obj * pBlock);
 //RL fuctions
 listobj *create_listobjRL(int num);
+void remove_listobj(listobj *obj);
 void insertRL(list *list, listobj *obj);
 listobj *extractRL(list *list);
 //MialBox fuctions
 mailbox * create_mailB();
+void remove_mailB(mailbox *mBox);
 void insertMB(mailbox *list, msg *obj);
 //void insertMB(mailbox *mb, msg *message)
 
 msg * createMsg();
+char * createMsgData(int size);
 
 void remove_MBoxmsg(msg *nMsg);
 void remove_msgRL(list * RL);
 void remove_OldMsg(mailbox *mBox);
+void insertRoom(mailbox *mBox, msg *obj);
+void extractRoom(mailbox *mBox, msg *obj);
 
 void remove_list(list * xList);
 
@@ -0,0 +1,294 @@
+/**************************************************************************//**
+ * @file     Lite.c
+ * @brief    ART Real Time Micro Kernel Lite.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Lightweight tasks
+******************************************************************************/
+
+#include "Lite.h"
+#include "Overload.h"
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+// State of the current kernel instance, see KernelCtx.h
+#define liteReady       (pKernel->liteReady)    /**< ready lite tasks sorted by DeadLine. */
+#define liteRunning     (pKernel->liteRunning)  /**< lite task the runner is in. */
+#define litePoll        (pKernel->litePoll)     /**< lite tasks polling a condition. */
+#define runnerObj       (pKernel->runnerObj)    /**< list item of the lite runner task. */
+
+/** \brief  make a lite task ready
+
+    Inserts the lite task in the ready list of the runner, sorted by
+    DeadLine. Must be called with interrupts disabled.
+
+    \param [in]      pLite: the lite task
+    \return          none
+ */
+static void lite_ready(lite *pLite){
+  lite **ppPos = &liteReady;
+  while(*ppPos != NULL && !DEADLINE_BEFORE(pLite->DeadLine, (*ppPos)->DeadLine)){
+    ppPos = &(*ppPos)->pNext;
+  }
+  pLite->pNext = *ppPos;
+  *ppPos = pLite;
+}
+
+/** \brief  move the lite runner to its place
+
+    Gives the runner the earliest deadline of the lite task it is in
+    and the ready lite tasks and puts it in the Readylist, or in the
+    Waitinglist without deadline when there is none. Deadlines that
+    are reached already do not count, a runner with only such lite
+    tasks runs in the BACKGROUND until they get a new deadline with
+    lite_set_deadline, so it does not hold the head of the Readylist.
+    Must be called with interrupts disabled.
+
+    \param [in]      none
+    \return          TRUE if the runner was moved
+ */
+static int lite_place_runner(void){
+  uint nDeadLine = NO_DEADLINE;
+  lite *pLite;
+  if(liteRunning != NULL && !DEADLINE_REACHED_AT(liteRunning->DeadLine, TC)){
+    nDeadLine = liteRunning->DeadLine;
+  }
+  for(pLite = liteReady; pLite != NULL; pLite = pLite->pNext){//Missed deadlines sort first
+    if(!DEADLINE_REACHED_AT(pLite->DeadLine, TC)){
+      if(DEADLINE_BEFORE(pLite->DeadLine, nDeadLine)){
+        nDeadLine = pLite->DeadLine;
+      }
+      break;
+    }
+  }
+  if(nDeadLine == NO_DEADLINE && (liteRunning != NULL || liteReady != NULL)){
+    nDeadLine = BACKGROUND;
+  }
+  if(runnerObj->pTask->DeadLine == nDeadLine && runnerObj->pNext != NULL){
+    return FALSE;
+  }
+  if(runnerObj->pNext != NULL){
+    extractWL(readyL, runnerObj); //Unlinks from the list it is in
+  }
+  runnerObj->pTask->DeadLine = nDeadLine;
+  insertRL(nDeadLine != NO_DEADLINE ? READY_LIST(runnerObj->pTask) : waitingL, runnerObj);
+  return TRUE;
+}
+
+/** \brief  reschedule the lite runner
+
+    Called by the runner between lite tasks with interrupts disabled.
+
+    \param [in]      none
+    \return          none
+ */
+static void lite_schedule(void){
+  volatile int firstExec = TRUE;
+  SaveContext(); //Save context
+  if(firstExec){
+    firstExec = FALSE;
+    if(lite_place_runner()){
+      dispatch();//Load context
+    }
+  }
+}
+
+/** \brief  lite runner task
+
+    Runs the ready lite tasks in deadline order on its own stack. A
+    body that waits for a Mailbox is queued on it and is made ready by
+    the next send to the Mailbox. A body whose LT_WAIT_UNTIL condition
+    is false is parked until the next tick, so polling does not keep
+    the runner ready and starve the full tasks.
+
+    \param [in]      none
+    \return          none
+ */
+static void lite_runner(void){
+  while(1){
+    lite *pLite;
+    int nResult;
+    int x = set_isr(ISR_OFF); //Disable interrupt
+    ISR_ENTER(ISR_SITE_LITE);
+    pLite = liteReady;
+    if(pLite != NULL){
+      liteReady = pLite->pNext;
+      pLite->pNext = NULL;
+      liteRunning = pLite;
+      ISR_EXIT();
+      set_isr(x);
+      nResult = pLite->pBody(pLite);
+      x = set_isr(ISR_OFF);
+      ISR_ENTER(ISR_SITE_LITE);
+      liteRunning = NULL;
+      if(nResult == LT_YIELDED){
+        lite_ready(pLite);
+      }
+      else if(nResult == LT_POLLING){
+        pLite->pNext = litePoll;
+        litePoll = pLite;
+      }
+      else if(nResult == LT_WAITING){
+        if(pLite->pWaitBox->nMessages > 0){//Sent while it was running
+          lite_ready(pLite);
+        }
+        else{
+          pLite->pNext = pLite->pWaitBox->pLite;
+          pLite->pWaitBox->pLite = pLite;
+        }
+      }
+    }
+    lite_schedule();
+    ISR_EXIT();
+    set_isr(x);
+  }
+}
+
+/** \brief  create a lite task
+
+    The lite struct is owned by the caller and must stay valid until
+    the body returns LT_ENDED. The first call creates the lite runner
+    and must be made in start up mode. The body must not make blocking
+    kernel calls, see Lite.h.
+
+    \param [in]    pLite: the lite task.
+    \param [in]    body: the body, resumed at its last continuation point.
+    \param [in]    deadline: the deadline of the lite task.
+    \return        FAIL/OK: Description of the function's status.
+ */
+exception create_lite(lite* pLite, int (*body)(lite* pLite), uint deadline){
+  volatile int firstExec = TRUE;
+  int x;
+  if(!deadline || body == NULL){
+    return FAIL;
+  }
+  if(runnerObj == NULL){
+    if(kernelMode == RUNNING){
+      return FAIL;
+    }
+    runnerObj = new_task(lite_runner, deadline);
+    if(runnerObj == NULL){
+      return FAIL;
+    }
+    runnerObj->pTask->Policy = MISS_KERNEL; //The lites handle their own misses
+    insertRL(READY_LIST(runnerObj->pTask), runnerObj);
+    uppdateRunning();
+  }
+  pLite->pBody = body;
+  pLite->DeadLine = deadline;
+  pLite->nLine = 0;
+  pLite->pWaitBox = NULL;
+  x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_LITE);
+  lite_ready(pLite);
+  if(kernelMode == INIT){
+    lite_place_runner();
+    uppdateRunning();
+  }
+  else{
+    SaveContext(); //Save context
+    if(firstExec){
+      firstExec = FALSE;
+      if(lite_place_runner()){
+        dispatch();//Load context
+      }
+    }
+  }
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  set the deadline of a lite task
+
+    Called by the body of the lite task, e.g. to advance to its next
+    period before it yields or waits. The runner takes the new
+    deadline when the body returns.
+
+    \param [in]    pLite: the running lite task.
+    \param [in]    nDeadline: the new deadline given in number of ticks.
+    \return        FAIL/OK: FAIL for no deadline or a lite task that
+                            is not running.
+ */
+exception lite_set_deadline(lite* pLite, uint nDeadline){
+  int x;
+  if(!nDeadline){
+    return FAIL;
+  }
+  x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_LITE);
+  if(pLite != liteRunning){
+    ISR_EXIT();
+    set_isr(x);
+    return FAIL;
+  }
+  pLite->DeadLine = nDeadline;
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  wake the lite tasks waiting on a Mailbox
+
+    Called by the send calls when a Message is put in the Mailbox,
+    with interrupts disabled.
+
+    \param [in]      mBox: the Mailbox
+    \return          TRUE if the caller has to reschedule
+ */
+int lite_notify(mailbox* mBox){
+  lite *pLite = mBox->pLite;
+  if(pLite == NULL){
+    return FALSE;
+  }
+  mBox->pLite = NULL;
+  while(pLite != NULL){
+    lite *pNext = pLite->pNext;
+    lite_ready(pLite);
+    pLite = pNext;
+  }
+  return lite_place_runner();
+}
+
+/** \brief  try the polling lite tasks again
+
+    Called by the tick work. The lite tasks parked by LT_WAIT_UNTIL
+    are made ready to test their condition once more.
+
+    \param [in]      none
+    \return          none
+ */
+void lite_tick(void){
+  lite *pLite;
+  int x;
+  if(litePoll == NULL){
+    return;
+  }
+  x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_LITE);
+  pLite = litePoll;
+  litePoll = NULL;
+  while(pLite != NULL){
+    lite *pNext = pLite->pNext;
+    lite_ready(pLite);
+    pLite = pNext;
+  }
+  lite_place_runner();
+  ISR_EXIT();
+  set_isr(x);
+}
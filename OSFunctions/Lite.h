@@ -0,0 +1,31 @@
+/**
+ * @file Lite.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the lightweight stackless tasks.
+ *
+ * Lite tasks are run one at a time by the lite runner, a normal task
+ * whose deadline follows the earliest ready lite task. A lite task
+ * costs the lite struct and its own state instead of a TCB.
+ *
+ * A lite body runs on the stack of the runner and must only make
+ * kernel calls that do not block. A blocking call parks the runner in
+ * the Waitinglist or Timerlist, and the runner is moved from there to
+ * the Readylist when a lite task becomes ready, which breaks the wait.
+ *
+ * A periodic lite task advances its deadline with lite_set_deadline. A
+ * deadline that has passed no longer sets the deadline of the runner.
+ */
+
+#ifndef Lite_H
+#define Lite_H
+#include "kernel.h"
+#include "Listor.h"
+#include "TaskAdministration.h"
+
+exception create_lite(lite* pLite, int (*body)(lite* pLite), uint deadline);
+exception lite_set_deadline(lite* pLite, uint nDeadline);
+int lite_notify(mailbox* mBox);
+void lite_tick(void);
+
+#endif
@@ -0,0 +1,110 @@
+/**************************************************************************//**
+ * @file     MsgStats.c
+ * @brief    ART Real Time Micro Kernel MsgStats.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Message latency instrumentation
+******************************************************************************/
+
+#include "MsgStats.h"
+#include "TaskAdministration.h"
+
+/** \brief  histogram bucket of a latency
+
+    \param [in]      nTime: the latency in timer counts
+    \return          the bucket
+ */
+static uint msg_bucket(uint nTime){
+  uint nBucket = 0;
+  while((nTime >>= 1) != 0 && nBucket < MSG_HIST_BUCKETS-1){
+    nBucket++;
+  }
+  return nBucket;
+}
+
+/** \brief  stamp a Message that is sent
+
+    The origin is the one the running task received last, or the send
+    time when it has not received any. Must be called with interrupts
+    disabled.
+
+    \param [in]      pMsg: the Message, or the Message of the waiting
+                           receiver it is copied to
+    \return          none
+ */
+void msg_stat_send(msg *pMsg){
+  pMsg->nStamp = timer0_stamp();
+  pMsg->nOrigin = Running->nOrigin != 0 ? Running->nOrigin : pMsg->nStamp;
+  if(pMsg->nOrigin == 0){
+    pMsg->nOrigin = 1; //0 means no origin
+  }
+}
+
+/** \brief  record a Message that is received
+
+    Must be called with interrupts disabled.
+
+    \param [in]      mBox: the Mailbox it was received from
+    \param [in]      pMsg: the Message
+    \param [in]      pTask: the receiving task, it takes over the origin
+    \return          none
+ */
+void msg_stat_receive(mailbox *mBox, msg *pMsg, TCB *pTask){
+  msgstat *pStats = mBox->pStats;
+  pTask->nOrigin = pMsg->nOrigin;
+  if(pStats != NULL){
+    uint nNow = timer0_stamp();
+    uint nQueue = nNow - pMsg->nStamp;
+    uint nEnd = nNow - pMsg->nOrigin;
+    pStats->nCount++;
+    pStats->Queue[msg_bucket(nQueue)]++;
+    pStats->EndToEnd[msg_bucket(nEnd)]++;
+    if(nQueue > pStats->nMaxQueue){
+      pStats->nMaxQueue = nQueue;
+    }
+    if(nEnd > pStats->nMaxEndToEnd){
+      pStats->nMaxEndToEnd = nEnd;
+    }
+  }
+}
+
+/** \brief  set the latency statistics of a Mailbox
+
+    The statistics are recorded from now on when KERNEL_MSG_STATS is
+    defined, they are not cleared here. NULL stops the recording.
+
+    \param [in]      mBox: the Mailbox
+    \param [in]      pStats: the statistics, owned by the caller
+    \return          none
+ */
+void set_mailbox_stats(mailbox *mBox, msgstat *pStats){
+  int x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_MSG_STATS);
+  mBox->pStats = pStats;
+  ISR_EXIT();
+  set_isr(x);
+}
+
+/** \brief  age of the data the running task works on
+
+    \param [in]      none
+    \return          timer counts since the start of the chain of the
+                     last received Message, 0 without one
+ */
+uint msg_age(void){
+  uint nOrigin = Running->nOrigin;
+  return nOrigin != 0 ? timer0_stamp() - nOrigin : 0;
+}
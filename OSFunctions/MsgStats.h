@@ -0,0 +1,35 @@
+/**
+ * @file MsgStats.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the Message latency instrumentation.
+ *
+ * Compiled in when KERNEL_MSG_STATS is defined in kernel.h. Every Message
+ * is stamped when it is sent. When it is received, the queueing delay
+ * is recorded in the msgstat of its Mailbox, if the Mailbox has one.
+ * The time since the start of the chain is recorded there as well.
+ *
+ * A chain starts at a task that has not received a Message. A task
+ * that receives a Message keeps its origin stamp and passes it on with
+ * the Messages it sends, so the payload is not touched. The EndToEnd
+ * histogram of the last Mailbox of a pipeline holds its total latency.
+ */
+
+#ifndef MsgStats_H
+#define MsgStats_H
+#include "kernel.h"
+
+#ifdef KERNEL_MSG_STATS
+#define MSG_SEND(pMsg)                  msg_stat_send(pMsg)
+#define MSG_RECEIVE(mBox, pMsg, pTask)  msg_stat_receive((mBox), (pMsg), (pTask))
+#else
+#define MSG_SEND(pMsg)
+#define MSG_RECEIVE(mBox, pMsg, pTask)
+#endif
+
+void msg_stat_send(msg *pMsg);
+void msg_stat_receive(mailbox *mBox, msg *pMsg, TCB *pTask);
+void set_mailbox_stats(mailbox *mBox, msgstat *pStats);
+uint msg_age(void);
+
+#endif
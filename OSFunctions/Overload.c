@@ -0,0 +1,207 @@
+/**************************************************************************//**
+ * @file     Overload.c
+ * @brief    ART Real Time Micro Kernel Overload.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Overload management
+******************************************************************************/
+
+#include "Overload.h"
+#include "Communication.h"
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+#define missCount       (pKernel->missCount)    /**< deadline misses per policy. */
+
+/** \brief  set the overload policy of the calling task
+
+    \param [in]    nPolicy: MISS_NONE, MISS_ABORT, MISS_SKIP, MISS_DEMOTE or MISS_HANDLER
+    \param [in]    nPeriod: the period in ticks of MISS_SKIP and MISS_ABORT,
+                            0 makes MISS_ABORT terminate the task
+    \param [in]    pMiss:   the handler of MISS_HANDLER, it is called by the
+                            tick work with the TCB of the task. It runs in the
+                            work context with interrupts enabled, not in the
+                            interrupt handler, and must not block
+    \return        FAIL/OK: FAIL for an unknown policy or missing period or handler
+ */
+exception set_miss_policy(uint nPolicy, uint nPeriod, void (*pMiss)(void *pTask)){
+  int x;
+  if(nPolicy >= MISS_POLICIES || (nPolicy == MISS_SKIP && nPeriod == 0) ||
+     (nPolicy == MISS_HANDLER && pMiss == NULL)){
+    return FAIL;
+  }
+  x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_OVERLOAD);
+  Running->Policy = nPolicy;
+  Running->nPeriod = nPeriod;
+  Running->pMiss = pMiss;
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  return the number of deadline misses
+
+    \param [in]    nPolicy: the policy the misses were handled with
+    \return        the number of misses since start
+ */
+uint miss_count(uint nPolicy){
+  return nPolicy < MISS_POLICIES ? missCount[nPolicy] : 0;
+}
+
+/** \brief  move the deadline to the next period that is not reached
+
+    \param [in]      pTask: the task
+    \return          none
+ */
+static void next_period(TCB *pTask){
+  do{
+    pTask->DeadLine += pTask->nPeriod;
+  }while(DEADLINE_REACHED_AT(pTask->DeadLine, TC));
+}
+
+/** \brief  abort the job of a task
+
+    Restarts the task at its body with the deadline of its next period,
+    or terminates it without a period. The task must be in the
+    Readylist and must not be inside a blocking call, neither one that
+    still has to clean up nor one that was woken with its Message.
+    The tick work runs in the work context, so a task aborted there is
+    never the one executing. A task that aborts itself from miss_resume
+    is replaced by the next task before its TCB is freed, as in
+    terminate.
+
+    \param [in]      pObj: the list item of the task
+    \return          none
+ */
+static void miss_abort(listobj *pObj){
+  TCB *pTask = pObj->pTask;
+  pTask->bAbort = FALSE;
+  extractWL(READY_LIST(pTask), pObj);
+  if(pTask->nPeriod == 0){
+    drop_call(pTask);
+    if(pTask == Running){
+      uppdateRunning(); //Charge it and leave its TCB before it is freed
+    }
+    remove_listobj(pObj);
+    HEAP_LEAKS_OF(pTask);
+    return;
+  }
+  next_period(pTask);
+  pTask->PC = pTask->Body;
+  pTask->SP = &(pTask->StackSeg[STACK_SIZE-1]);
+  pTask->SPSR = 0;
+  insertRL(READY_LIST(pTask), pObj);
+}
+
+/** \brief  apply the overload policies to one Readylist
+
+    The Readylist is sorted on DeadLine, so only the tasks at the head
+    that have reached their deadline are visited, each miss is handled
+    once. MISS_ABORT is deferred while the task is inside a blocking
+    call: a call woken by the deadline aborts in miss_resume after its
+    clean up, a call woken with OK completes and the task is aborted
+    at a later tick, once it has run. Misses of the kernel contexts
+    are not counted.
+
+    \param [in]      pList: the Readylist
+    \return          none
+ */
+static void miss_check_list(list *pList){
+  listobj *pObj = pList->pHead->pNext;
+  while(pObj != pList->pTail && DEADLINE_REACHED_AT(pObj->pTask->DeadLine, TC)){
+    listobj *pNext = pObj->pNext;
+    TCB *pTask = pObj->pTask;
+    if(pTask->Policy != MISS_KERNEL && pTask->nMissDeadLine != pTask->DeadLine){
+      pTask->nMissDeadLine = pTask->DeadLine;
+      missCount[pTask->Policy]++;
+      switch(pTask->Policy){
+      case MISS_ABORT:
+        pTask->bAbort = TRUE; //Below once it is not inside a blocking call
+        break;
+      case MISS_SKIP:
+        next_period(pTask);
+        insertRL(pList, extractWL(pList, pObj));
+        break;
+      case MISS_DEMOTE:
+        pTask->DeadLine = BACKGROUND;
+        insertRL(pList, extractWL(pList, pObj));
+        break;
+      case MISS_HANDLER:
+        pTask->pMiss(pTask);
+        break;
+      }
+    }
+    if(pTask->bAbort && pObj->Status == OK && !pTask->bWoken){//Preempted in its own code
+      miss_abort(pObj);
+    }
+    pObj = pNext;
+  }
+}
+
+/** \brief  end the demotion of a task
+
+    Called when a task is made ready. A task demoted by MISS_DEMOTE
+    gets the deadline of its current period back once it has blocked,
+    e.g. in the wait for its next period. Without a period it stays in
+    the background until it calls set_deadline. Must be called with
+    interrupts disabled or from the tick work, before the task is
+    inserted in the Readylist.
+
+    \param [in]      pTask: the task
+    \return          none
+ */
+void miss_restore(TCB *pTask){
+  if(pTask->DeadLine == BACKGROUND && pTask->Policy == MISS_DEMOTE && pTask->nPeriod != 0){
+    pTask->DeadLine = pTask->nMissDeadLine;
+    next_period(pTask);
+  }
+}
+
+/** \brief  apply the overload policies
+
+    Called by the tick work after expired waiters were made ready, to
+    the Readylists of all partitions.
+
+    \param [in]      none
+    \return          none
+ */
+void miss_check(void){
+  partition *pPart;
+  miss_check_list(readyMain);
+  for(pPart = partFirst; pPart != NULL; pPart = pPart->pNext){
+    miss_check_list(pPart->pReady);
+  }
+}
+
+/** \brief  abort after the clean up of a blocking call
+
+    Called by a blocking call that was woken by its deadline, after it
+    has cleaned up and with interrupts disabled. Does not return when
+    the job is aborted, the next context is loaded with interrupts
+    still disabled.
+
+    \param [in]      none
+    \return          none
+ */
+void miss_resume(void){
+  if(Running->bAbort){
+    miss_abort(readyL->pHead->pNext);
+    dispatch();//Load context
+  }
+}
@@ -0,0 +1,30 @@
+/**
+ * @file Overload.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the overload policies on deadline misses.
+ *
+ * A task that misses its deadline gets the overload policy it has set
+ * with set_miss_policy(). The policy is applied by the tick work at
+ * the tick the deadline is reached, so a late task does not keep the
+ * head of the Readylist and make the other tasks miss as well. The
+ * tick work and so the policies and miss handlers run in the work
+ * context, at task level with interrupts enabled. A task aborted
+ * while inside a blocking call is aborted once it is out of the call.
+ * The kernel contexts have MISS_KERNEL, their misses are ignored.
+ */
+
+#ifndef Overload_H
+#define Overload_H
+#include "kernel.h"
+#include "TaskAdministration.h"
+
+#define MISS_KERNEL     MISS_POLICIES   /**< policy of the kernel contexts, their misses are not handled or counted. */
+
+exception set_miss_policy(uint nPolicy, uint nPeriod, void (*pMiss)(void *pTask));
+uint miss_count(uint nPolicy);
+void miss_check(void);
+void miss_restore(TCB *pTask);
+void miss_resume(void);
+
+#endif
@@ -0,0 +1,180 @@
+/**************************************************************************//**
+ * @file     Partition.c
+ * @brief    ART Real Time Micro Kernel Partition.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Time partitions
+******************************************************************************/
+
+#include "Partition.h"
+#include "KernelCtx.h"
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+// State of the current kernel instance, see KernelCtx.h
+#define partCharge      (pKernel->partCharge)   /**< partition charged for the time, NULL for none. */
+#define partFrame       (pKernel->partFrame)    /**< partition frame in ticks. */
+#define partTick        (pKernel->partTick)     /**< tick in the partition frame. */
+
+/** \brief  budget given to the partitions
+
+    \param [in]      none
+    \return          the sum of the budgets
+ */
+static uint partition_budgets(void){
+  partition *pPart;
+  uint nSum = 0;
+  for(pPart = partFirst; pPart != NULL; pPart = pPart->pNext){
+    nSum += pPart->nBudget;
+  }
+  return nSum;
+}
+
+/** \brief  set the partition frame
+
+    The budgets of all partitions are given back at the start of every
+    frame, the first frame starts at run. Must be called in start up
+    mode before the partitions are created.
+
+    \param [in]    nTicks: the frame in ticks
+    \return        FAIL/OK: FAIL in running mode, for no ticks or when the
+                            budgets of the partitions do not fit
+ */
+exception set_partition_frame(uint nTicks){
+  if(kernelMode == RUNNING || nTicks == 0 || partition_budgets() > nTicks){
+    return FAIL;
+  }
+  partFrame = nTicks;
+  partTick = 0;
+  return OK;
+}
+
+/** \brief  create a time partition
+
+    Must be called in start up mode after set_partition_frame. The
+    budgets of all partitions must fit in the frame. In the static
+    configuration the Readylist of a partition comes from the
+    CFG_MAX_LISTS pool.
+
+    \param [in]    pPart: the partition, owned by the caller.
+    \param [in]    nBudget: the ticks it gets in every frame.
+    \param [in]    nFlags: PART_DONATE or 0.
+    \return        FAIL/OK: FAIL in running mode, for a budget that does
+                            not fit or when the Readylist cannot be created
+ */
+exception create_partition(partition* pPart, uint nBudget, uint nFlags){
+  partition **ppLast = &partFirst;
+  if(kernelMode == RUNNING || pPart == NULL || nBudget == 0 || partFrame == 0 ||
+     partition_budgets() + nBudget > partFrame){
+    return FAIL;
+  }
+  pPart->pReady = create_list();
+  if(pPart->pReady == NULL){
+    return FAIL;
+  }
+  pPart->nBudget = nBudget;
+  pPart->nLeft = nBudget;
+  pPart->nFlags = nFlags;
+  pPart->pNext = NULL;
+  while(*ppLast != NULL){
+    ppLast = &(*ppLast)->pNext;
+  }
+  *ppLast = pPart;
+  return OK;
+}
+
+/** \brief  partition of the tasks created next
+
+    Tasks and lite tasks created in start up mode go into the given
+    partition. A task created by a running task goes into the partition
+    of its creator.
+
+    \param [in]    pPart: the partition, NULL for no partition.
+    \return        FAIL/OK: FAIL in running mode
+ */
+exception use_partition(partition* pPart){
+  if(kernelMode == RUNNING){
+    return FAIL;
+  }
+  partNew = pPart;
+  return OK;
+}
+
+/** \brief  choose the partition that runs
+
+    The first partition with budget left and a ready task runs on its
+    budget. Without one, the budget of the first donating partition with
+    budget left is given to the first partition with a ready task.
+    Otherwise the tasks outside of all partitions run. Called by
+    uppdateRunning() with interrupts disabled.
+
+    \param [in]      none
+    \return          none
+ */
+void partition_select(void){
+  partition *pPart;
+  partition *pDonor = NULL;
+  for(pPart = partFirst; pPart != NULL; pPart = pPart->pNext){
+    if(pPart->nLeft == 0){
+      continue;
+    }
+    if(pPart->pReady->pHead->pNext != pPart->pReady->pTail){
+      readyL = pPart->pReady;
+      partCharge = pPart;
+      return;
+    }
+    if(pDonor == NULL && (pPart->nFlags & PART_DONATE)){
+      pDonor = pPart;
+    }
+  }
+  if(pDonor != NULL){
+    for(pPart = partFirst; pPart != NULL; pPart = pPart->pNext){
+      if(pPart->pReady->pHead->pNext != pPart->pReady->pTail){
+        readyL = pPart->pReady;
+        partCharge = pDonor;
+        return;
+      }
+    }
+  }
+  readyL = readyMain;
+  partCharge = NULL;
+}
+
+/** \brief  charge a tick to the partition that runs
+
+    Called by TimerInt when TC is incremented, Running is updated by
+    the caller.
+
+    \param [in]      none
+    \return          none
+ */
+void partition_tick(void){
+  partition *pPart;
+  if(partFirst == NULL){
+    return;
+  }
+  if(partCharge != NULL && partCharge->nLeft > 0){
+    partCharge->nLeft--;
+  }
+  if(++partTick == partFrame){
+    partTick = 0;
+    for(pPart = partFirst; pPart != NULL; pPart = pPart->pNext){
+      pPart->nLeft = pPart->nBudget;
+    }
+  }
+}
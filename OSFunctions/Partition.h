@@ -0,0 +1,28 @@
+/**
+ * @file Partition.h
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the time partitions.
+ *
+ * A partition has its own Readylist, sorted on DeadLine as the kernel
+ * Readylist, and a budget of ticks per partition frame. readyL points
+ * to the Readylist of the partition that runs, so the kernel calls
+ * work inside a partition as before. Partitions are served in the
+ * order they were created while they have budget left and a ready
+ * task. The tasks outside of all partitions, Idle among them, run in
+ * the time the partitions leave. A tick is charged to the partition
+ * that runs at the tick.
+ */
+
+#ifndef Partition_H
+#define Partition_H
+#include "kernel.h"
+#include "Listor.h"
+
+exception create_partition(partition* pPart, uint nBudget, uint nFlags);
+exception use_partition(partition* pPart);
+exception set_partition_frame(uint nTicks);
+void partition_select(void);
+void partition_tick(void);
+
+#endif
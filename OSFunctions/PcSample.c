@@ -0,0 +1,83 @@
+/**************************************************************************//**
+ * @file     PcSample.c
+ * @brief    ART Real Time Micro Kernel PcSample.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Statistical PC-sampling profiler
+******************************************************************************/
+
+#include <string.h>
+#include "PcSample.h"
+#include "KernelCtx.h"
+#include "IsrStats.h"
+#include "../kernel_hwdep.h"
+
+#ifdef KERNEL_PC_SAMPLES
+
+/*********************************************************/
+/** Global variabels and definitions                     */
+/*********************************************************/
+
+pc_ring pcRing;                 /**< samples written by TimerInt. */
+
+/** \brief  read the samples taken since the last read
+
+    Copies the samples in the order they were taken. When more than
+    PC_SAMPLES were taken since the last read the oldest are lost.
+    The ring can also be dumped from the debugger as it is, the
+    next sample goes to pcRing.nCount % PC_SAMPLES.
+
+    \param [out]     pOut: room for nMax samples
+    \param [in]      nMax: the number of samples that fit in pOut
+    \param [out]     pLost: samples overwritten before they were read, may be NULL
+    \return          the number of samples copied
+ */
+uint pc_samples_read(pc_sample *pOut, uint nMax, uint *pLost){
+  uint nLost = 0;
+  uint n = 0;
+  int x = set_isr(ISR_OFF);
+  uint nNew;
+  ISR_ENTER(ISR_SITE_PC_SAMPLE);
+  nNew = pcRing.nCount - pcRing.nRead;
+  if(nNew > PC_SAMPLES){
+    nLost = nNew - PC_SAMPLES;
+    pcRing.nRead += nLost;
+  }
+  while(n < nMax && pcRing.nRead != pcRing.nCount){
+    pOut[n++] = pcRing.aSample[pcRing.nRead++ & (PC_SAMPLES-1)];
+  }
+  ISR_EXIT();
+  set_isr(x);
+  if(pLost != NULL){
+    *pLost = nLost;
+  }
+  return n;
+}
+
+/** \brief  drop all samples
+
+    \param [in]      none
+    \return          none
+ */
+void pc_samples_reset(void){
+  int x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_PC_SAMPLE);
+  memset(&pcRing, 0, sizeof(pcRing));
+  ISR_EXIT();
+  set_isr(x);
+}
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * @file PcSample.h
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the statistical PC-sampling profiler.
+ *
+ * Compiled in when KERNEL_PC_SAMPLES is defined in kernel.h, otherwise the
+ * PC_SAMPLE macro expands to nothing and neither the ring nor the read
+ * calls exist. Every tick TimerInt records where
+ * the Running task was interrupted and which task it was. The ring is
+ * read with pc_samples_read and symbolized on the host with
+ * tools/pc-profile.py.
+ */
+
+#ifndef PcSample_H
+#define PcSample_H
+#include "kernel.h"
+
+#define PC_SAMPLES      1024    /**< samples kept, a power of two. */
+
+// One tick sample
+typedef struct {
+  void          (*PC)();        // interrupted PC, saved by the IRQ handler
+  void          (*Body)();      // body of the interrupted task
+} pc_sample;
+
+// Ring of the last PC_SAMPLES samples
+typedef struct {
+  pc_sample     aSample[PC_SAMPLES];
+  uint          nCount;         // samples taken, the next one goes to nCount % PC_SAMPLES
+  uint          nRead;          // samples taken when the ring was read last
+} pc_ring;
+
+#ifdef KERNEL_PC_SAMPLES
+extern pc_ring pcRing;
+
+// Called by TimerInt while the context of Running is saved in its TCB
+#define PC_SAMPLE() \
+  do{ \
+    if(Running != NULL){ \
+      pc_sample *pSample = &pcRing.aSample[pcRing.nCount++ & (PC_SAMPLES-1)]; \
+      pSample->PC = Running->PC; \
+      pSample->Body = Running->Body; \
+    } \
+  }while(0)
+
+uint pc_samples_read(pc_sample *pOut, uint nMax, uint *pLost);
+void pc_samples_reset(void);
+#else
+#define PC_SAMPLE()
+#endif
+
+#endif
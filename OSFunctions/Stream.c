@@ -0,0 +1,338 @@
+/**************************************************************************//**
+ * @file     Stream.c
+ * @brief    ART Real Time Micro Kernel Stream.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Byte-stream buffers
+******************************************************************************/
+
+#include <string.h>
+#include "Stream.h"
+
+/** \brief  copy bytes into the ring
+
+    Copies as many bytes as fit and wakes the reader when its trigger
+    level is reached. Must be called with interrupts disabled.
+
+    \param [in]      pStream: the stream
+    \param [in]      pData: the bytes
+    \param [in]      nBytes: the number of bytes
+    \param [out]     pWoken: set to TRUE when the reader was woken
+    \return          the number of bytes copied
+ */
+static uint stream_put(stream *pStream, const char *pData, uint nBytes, int *pWoken){
+  uint nFree = pStream->nSize - pStream->nCount;
+  uint nLast = (pStream->nFirst + pStream->nCount) % pStream->nSize;
+  uint nPart;
+  if(nBytes > nFree){
+    nBytes = nFree;
+  }
+  nPart = pStream->nSize - nLast < nBytes ? pStream->nSize - nLast : nBytes;
+  memcpy(pStream->pBuf + nLast, pData, nPart);
+  memcpy(pStream->pBuf, pData + nPart, nBytes - nPart);
+  pStream->nCount += nBytes;
+  if(pStream->pReader != NULL && pStream->pReader->Status == OK &&
+     pStream->nCount >= pStream->nWant){ //Not a reader already woken by its deadline
+    wake_task(pStream->pReader, OK);
+    pStream->pReader = NULL;
+    *pWoken = TRUE;
+  }
+  return nBytes;
+}
+
+/** \brief  copy bytes out of the ring
+
+    Copies up to nMax bytes and wakes the writer when it has room.
+    Must be called with interrupts disabled.
+
+    \param [in]      pStream: the stream
+    \param [out]     pData: room for nMax bytes
+    \param [in]      nMax: the number of bytes wanted
+    \param [out]     pWoken: set to TRUE when the writer was woken
+    \return          the number of bytes copied
+ */
+static uint stream_get(stream *pStream, char *pData, uint nMax, int *pWoken){
+  uint nBytes = nMax < pStream->nCount ? nMax : pStream->nCount;
+  uint nPart = pStream->nSize - pStream->nFirst < nBytes ? pStream->nSize - pStream->nFirst : nBytes;
+  memcpy(pData, pStream->pBuf + pStream->nFirst, nPart);
+  memcpy(pData + nPart, pStream->pBuf, nBytes - nPart);
+  pStream->nFirst = (pStream->nFirst + nBytes) % pStream->nSize;
+  pStream->nCount -= nBytes;
+  if(pStream->pWriter != NULL && pStream->pWriter->Status == OK &&
+     pStream->nSize - pStream->nCount >= pStream->nRoom){ //Not a writer already woken by its deadline
+    wake_task(pStream->pWriter, OK);
+    pStream->pWriter = NULL;
+    *pWoken = TRUE;
+  }
+  return nBytes;
+}
+
+/** \brief  create a stream
+
+    In the static configuration the ring comes from the Message data
+    pools, so nSize is at most CFG_MSG_DATA_SIZE, and the stream from
+    the CFG_MAX_STREAMS pool.
+
+    \param [in]    nSize: the size of the ring in bytes.
+    \param [in]    nTrigger: the bytes that wake a blocked reader, 1 to nSize.
+    \return        stream*: a pointer to the created stream or NULL.
+ */
+stream* create_stream( uint nSize, uint nTrigger ){
+  stream *pStream;
+  if(nSize == 0 || nTrigger == 0 || nTrigger > nSize){
+    return NULL;
+  }
+  pStream = (stream *)kmem_alloc(KOBJ_STREAM, sizeof(stream));
+  if(pStream == NULL){
+    return NULL;
+  }
+  pStream->pBuf = (char *)kmem_alloc(KOBJ_DATA, nSize);
+  if(pStream->pBuf == NULL){
+    kmem_free(KOBJ_STREAM, pStream);
+    return NULL;
+  }
+  HEAP_OWNER(pStream, pStream); //The stream is not a leak of its creator
+  HEAP_OWNER(pStream->pBuf, pStream); //The ring goes with the stream
+  pStream->nSize = nSize;
+  pStream->nFirst = 0;
+  pStream->nCount = 0;
+  pStream->nTrigger = nTrigger;
+  pStream->pReader = NULL;
+  pStream->pWriter = NULL;
+  return pStream;
+}
+
+/** \brief  remove a stream
+
+    Bytes still in the ring are dropped.
+
+    \param [in]    pStream: the stream.
+    \return        OK/FAIL: FAIL if a task is blocked on the stream.
+ */
+exception remove_stream( stream* pStream ){
+  int x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_STREAM);
+  if(pStream->pReader != NULL || pStream->pWriter != NULL){
+    ISR_EXIT();
+    set_isr(x);
+    return FAIL;
+  }
+  kmem_free(KOBJ_DATA, pStream->pBuf);
+  kmem_free(KOBJ_STREAM, pStream);
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  bytes in a stream
+
+    \param [in]    pStream: the stream.
+    \return        the number of bytes that can be read.
+ */
+uint stream_bytes( stream* pStream ){
+  return pStream->nCount;
+}
+
+/** \brief  write to a stream, block until all bytes are written
+
+    Writes what fits and waits for room for the rest, a wait ends when
+    half of the ring is free or there is room for all bytes left. The
+    bytes written before the deadline stay in the stream.
+
+    \param [in]    pStream: the stream.
+    \param [in]    pData: the bytes.
+    \param [in]    nBytes: the number of bytes.
+    \return        OK: Normal function, no exception occurred.
+    \return        FAIL: another task is blocked writing to the stream.
+    \return        DEADLINE_REACHED: the deadline of the task is reached.
+ */
+exception stream_send_wait( stream* pStream, void* pData, uint nBytes ){
+  volatile int firstExec;
+  volatile uint nDone = 0;
+  int woken = FALSE;
+  listobj *pObj;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_STREAM);
+  pObj = readyL->pHead->pNext; //The caller, a woken reader may go ahead of it
+  while(1){
+    nDone += stream_put(pStream, (const char *)pData + nDone, nBytes - nDone, &woken);
+    if(nDone == nBytes){
+      break;
+    }
+    if(pStream->pWriter != NULL){
+      ISR_EXIT();
+      set_isr(x);
+      return FAIL;
+    }
+    firstExec = TRUE;
+    SaveContext(); //Save context
+    if(firstExec){//Block until there is room
+      firstExec = FALSE;
+      pStream->nRoom = nBytes - nDone < (pStream->nSize + 1) / 2 ? nBytes - nDone : (pStream->nSize + 1) / 2;
+      pObj->Status = OK;
+      pStream->pWriter = pObj;
+      insertRL(waitingL, extractWL(readyL, pObj));
+      dispatch();//Load context
+    }
+    x = set_isr(ISR_OFF); //Disable interrupt
+    ISR_ENTER(ISR_SITE_STREAM);
+    woken = FALSE;
+    if(pObj->Status != OK){//IF deadline is reached THEN
+      exception status = pObj->Status;
+      pObj->Status = OK;
+      pStream->pWriter = NULL;
+      miss_resume(); //Abort the job if that is its overload policy
+      ISR_EXIT();
+      set_isr(x);
+      return status;
+    }
+  }
+  if(woken){
+    firstExec = TRUE;
+    SaveContext(); //Save context
+    if(firstExec){
+      firstExec = FALSE;
+      dispatch();//Load context
+    }
+  }
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  write to a stream without blocking
+
+    Writes as many bytes as fit, a blocked reader whose trigger level
+    is reached is moved to the Readylist, which might lead to a
+    context switch.
+
+    \param [in]    pStream: the stream.
+    \param [in]    pData: the bytes.
+    \param [in]    nBytes: the number of bytes.
+    \return        the number of bytes written.
+ */
+uint stream_send_no_wait( stream* pStream, void* pData, uint nBytes ){
+  volatile int firstExec = TRUE;
+  volatile uint nDone = 0;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_STREAM);
+  SaveContext(); //Save context
+  if(firstExec){
+    int woken = FALSE;
+    firstExec = FALSE;
+    nDone = stream_put(pStream, (const char *)pData, nBytes, &woken);
+    if(woken){
+      dispatch();//Load context
+    }
+  }
+  ISR_EXIT();
+  set_isr(x);
+  return nDone;
+}
+
+/** \brief  read from a stream, block until bytes are available
+
+    Waits until the trigger level of the stream, or nMax if it is
+    lower, is reached and reads up to nMax bytes. A reader whose bytes
+    were taken by a stream_receive_no_wait before it ran blocks again.
+
+    \param [in]    pStream: the stream.
+    \param [out]   pData: room for nMax bytes.
+    \param [in]    nMax: the number of bytes wanted.
+    \param [out]   pGot: the number of bytes read.
+    \return        OK: Normal function, no exception occurred.
+    \return        FAIL: another task is blocked reading the stream.
+    \return        DEADLINE_REACHED: the deadline of the task is reached.
+ */
+exception stream_receive_wait( stream* pStream, void* pData, uint nMax, uint* pGot ){
+  volatile int firstExec;
+  uint nWant = nMax < pStream->nTrigger ? nMax : pStream->nTrigger;
+  int woken = FALSE;
+  listobj *pObj;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_STREAM);
+  pObj = readyL->pHead->pNext; //The caller
+  *pGot = 0;
+  while(pStream->nCount < nWant){
+    if(pStream->pReader != NULL){
+      ISR_EXIT();
+      set_isr(x);
+      return FAIL;
+    }
+    firstExec = TRUE;
+    SaveContext(); //Save context
+    if(firstExec){//Block until the trigger level is reached
+      firstExec = FALSE;
+      pStream->nWant = nWant;
+      pObj->Status = OK;
+      pStream->pReader = pObj;
+      insertRL(waitingL, extractWL(readyL, pObj));
+      dispatch();//Load context
+    }
+    x = set_isr(ISR_OFF); //Disable interrupt
+    ISR_ENTER(ISR_SITE_STREAM);
+    if(pObj->Status != OK){//IF deadline is reached THEN
+      exception status = pObj->Status;
+      pObj->Status = OK;
+      pStream->pReader = NULL;
+      miss_resume(); //Abort the job if that is its overload policy
+      ISR_EXIT();
+      set_isr(x);
+      return status;
+    }
+  }
+  *pGot = stream_get(pStream, (char *)pData, nMax, &woken);
+  if(woken){
+    firstExec = TRUE;
+    SaveContext(); //Save context
+    if(firstExec){
+      firstExec = FALSE;
+      dispatch();//Load context
+    }
+  }
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  read from a stream without blocking
+
+    Reads up to nMax bytes, a blocked writer that gets room is moved
+    to the Readylist, which might lead to a context switch.
+
+    \param [in]    pStream: the stream.
+    \param [out]   pData: room for nMax bytes.
+    \param [in]    nMax: the number of bytes wanted.
+    \return        the number of bytes read.
+ */
+uint stream_receive_no_wait( stream* pStream, void* pData, uint nMax ){
+  volatile int firstExec = TRUE;
+  volatile uint nDone = 0;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_STREAM);
+  SaveContext(); //Save context
+  if(firstExec){
+    int woken = FALSE;
+    firstExec = FALSE;
+    nDone = stream_get(pStream, (char *)pData, nMax, &woken);
+    if(woken){
+      dispatch();//Load context
+    }
+  }
+  ISR_EXIT();
+  set_isr(x);
+  return nDone;
+}
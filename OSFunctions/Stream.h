@@ -0,0 +1,41 @@
+/**
+ * @file Stream.h
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the byte-stream buffers.
+ *
+ * A stream is one byte ring shared by a writer and a reader. Writes
+ * and reads are partial, each byte is copied once into the ring and
+ * once out of it. A blocked reader is woken when the trigger level is
+ * reached, a blocked writer when half of the ring is free, so bulk data
+ * moves with few wakeups. Blocking ends at the deadline of the task.
+ */
+
+#ifndef Stream_H
+#define Stream_H
+#include "kernel.h"
+#include "Listor.h"
+#include "TaskAdministration.h"
+
+// Byte stream
+struct streamobj {
+  char            *pBuf;
+  uint            nSize;
+  uint            nFirst;       // Oldest byte
+  uint            nCount;       // Bytes in the ring
+  uint            nTrigger;     // Bytes that wake a blocked reader
+  listobj         *pReader;     // Task blocked in stream_receive_wait
+  uint            nWant;        // Bytes the reader waits for
+  listobj         *pWriter;     // Task blocked in stream_send_wait
+  uint            nRoom;        // Free bytes the writer waits for
+};
+
+stream* create_stream( uint nSize, uint nTrigger );
+exception remove_stream( stream* pStream );
+uint stream_bytes( stream* pStream );
+exception stream_send_wait( stream* pStream, void* pData, uint nBytes );
+uint stream_send_no_wait( stream* pStream, void* pData, uint nBytes );
+exception stream_receive_wait( stream* pStream, void* pData, uint nMax, uint* pGot );
+uint stream_receive_no_wait( stream* pStream, void* pData, uint nMax );
+
+#endif
@@ -22,31 +22,119 @@
 ******************************************************************************/
 
 #include "TaskAdministration.h"
+#include "Communication.h"
 
 
 /*********************************************************/
 /** Global variabels and definitions                     */
 /*********************************************************/
 
-list  *timmerL;   	/**< define timmerL Variable of type list. */
-list  *waitingL;        /**< define waitingL Variable of type list. */
-list  *readyL;          /**< define readyL Variable of type list. */
-uint  kernelMode;       /**< define kernel start up mode Variable  . */    
-TCB   *Running;         /**< define Running Variable of type TCB  . */ 
-uint  TC;               /**< define TC (no_of_ticks) Variable  . */ 
-int mymem_count_alloc;  /**< define mymem_count_alloc Variable to see allocated memory . */ 
-int mymem_count_free;   /**< define mymem_count_free Variable to see free memory . */ 
+#ifdef KERNEL_STATIC
+// Kernel list with its sentinels linked at compile time
+#define STATIC_LIST(name) \
+  static listobj name##Head, name##Tail; \
+  static listobj name##Head = { .pPrevious = &name##Head, .pNext = &name##Tail }; \
+  static listobj name##Tail = { .pPrevious = &name##Head, .pNext = &name##Tail }; \
+  static list name##List = { &name##Head, &name##Tail }
+
+STATIC_LIST(timer);
+STATIC_LIST(waiting);
+STATIC_LIST(ready);
+#endif
+static kernel_ctx kernelDefault;        /**< the kernel instance used unless another is selected. */
+KERNEL_TLS kernel_ctx *pKernel = &kernelDefault; /**< the kernel instance of the caller. */
+
+/** \brief  create a kernel instance
+
+    The instance is empty, select it with select_kernel and call
+    init_kernel to set it up. In the static configuration instances
+    come from a pool of CFG_MAX_KERNELS besides the default one, their
+    lists from the CFG_MAX_LISTS pool.
+
+    \param [in]      none
+    \return          the instance or NULL
+*/
+kernel_ctx *create_kernel(void){
+  kernel_ctx *pCtx = (kernel_ctx *)kmem_alloc(KOBJ_KERNEL, sizeof(kernel_ctx));
+  HEAP_OWNER(pCtx, pCtx); //The instance is not a leak of its creator
+  return pCtx;
+}
+
+/** \brief  select the kernel instance of the caller
+
+    All following kernel calls of the calling thread use this instance.
+    Without KERNEL_TLS there is one pKernel for the whole program, so
+    on the target it is only changed before run.
+
+    \param [in]      pCtx: the instance, NULL selects the default one
+    \return          none
+*/
+void select_kernel(kernel_ctx *pCtx){
+  pKernel = pCtx != NULL ? pCtx : &kernelDefault;
+}
 
 /** \brief  Update the running pointer
 
     This function keep the running pointer up to date by uppdating it as soon as
-    the readylist was modified 
+    the readylist was modified. Pending deferred work and then a running
+    slot of the cyclic schedule come before the Readylist. With partitions
+    readyL is first pointed at the Readylist of the partition to run.
 
     \param [in]      none
     \return          none
 */
 void uppdateRunning(){
- Running = readyL->pHead->pNext->pTask;
+ TCB *pNext;
+ if(partFirst != NULL){
+   partition_select();
+ }
+ pNext = work_context();
+ if(pNext == NULL){
+   pNext = cyclicJob != NULL ? cyclicJob : readyL->pHead->pNext->pTask;
+ }
+ if(pNext != Running){
+   cpu_switch(Running, pNext); //Charge the CPU time of the task that ran
+ }
+ pNext->bWoken = FALSE; //It completes its blocking call before it can be preempted
+ Running = pNext;
+}
+
+/** \brief  Make a blocked task ready
+
+    Moves a task from the Waitinglist to the Readylist and cancels a
+    pending timeout of a timed wait, both in constant time. The status
+    tells the task why it was made ready.
+
+    \param [in]      pObj:   the list item of the blocked task
+    \param [in]      status: OK if the communication was done, otherwise
+                             DEADLINE_REACHED or TIMEOUT
+    \return          none
+*/
+void wake_task(listobj *pObj, exception status){
+  cancel_timeout(pObj);
+  pObj->Status = status;
+  if(status == OK){
+    pObj->pMessage = NULL; //Message struct is removed by the waker
+  }
+  pObj->pTask->bWoken = TRUE;
+  miss_restore(pObj->pTask);
+  insertRL(READY_LIST(pObj->pTask), extractWL(waitingL, pObj));
+}
+
+/** \brief  dispatch the task with the tightest deadline
+
+    This function is the scheduling point of the kernel calls. The
+    running pointer is updated and its context is loaded, which is the
+    work context first when interrupt handlers posted work.
+    Must be called with interrupts disabled after SaveContext().
+
+    \param [in]      none
+    \return          none
+*/
+void dispatch(void){
+  uppdateRunning();
+  ISR_EXIT();
+  LoadContext();
 }
 
 
@@ -55,7 +143,9 @@ void uppdateRunning(){
 
   This function initializes the kernel and its data structures and leaves
   the kernel in start-up mode. The init_kernel call must be made before any 
-  other call is made to the kernel.
+  other call is made to the kernel. In the static configuration the lists
+  are already linked and only the idle task is created. It sets up the
+  kernel instance selected by select_kernel.
 
 \param [in]         none
 \return             FAIL/OK.  Int: Description of the functions status
@@ -64,26 +154,55 @@ exception init_kernel(void){
   if(kernelMode==RUNNING)  //return fail if the kernal is already running.
     return FAIL;
   set_ticks(0);			//1-Set tick counter to zero
-  timmerL=create_list(); 		//2-Create necessary data structures
-  waitingL=create_list();
-  readyL=create_list();
-  void (*pIdle)(void) = &Idle;	//3-Create an idle task
-  uint status = create_task(pIdle,5000 );//INT_MAX
+#ifdef KERNEL_STATIC
+  if(pKernel == &kernelDefault){ //The default instance has its lists linked
+    timmerL = &timerList;
+    waitingL = &waitingList;
+    readyL = &readyList;
+  }
+#endif
+  if(readyL == NULL){
+    timmerL=create_list(); 		//2-Create necessary data structures
+    waitingL=create_list();
+    readyL=create_list();
+    if(timmerL == NULL || waitingL == NULL ||  readyL == NULL){
+      if(timmerL != NULL) remove_list(timmerL);
+      if(waitingL != NULL) remove_list(waitingL);
+      if(readyL != NULL) remove_list(readyL);
+      timmerL = waitingL = readyL = NULL;
+      return FAIL; //5-Return status
+    }
+  }
+  readyMain = readyL;
+  if(init_work() != OK){ //Context that runs the deferred work
+    return FAIL;
+  }
   kernelMode =INIT;		//4-Set the kernel in start up mode
-  if(timmerL == NULL || waitingL == NULL ||  readyL == NULL || status == FAIL){
-    free(timmerL->pHead);
-    free(timmerL->pTail);
-    free(timmerL);
-    free(waitingL->pHead);
-    free(waitingL->pTail);
-    free(waitingL);
-    free(readyL->pHead);
-    free(readyL->pTail);
-    free(readyL);
-    return FAIL; //5-Return status
+  void (*pIdle)(void) = &Idle;	//3-Create an idle task
+  return create_task(pIdle,NO_DEADLINE ); //5-Return status
+}
+
+/** \brief  allocate and set up a task
+
+    Allocates the list item and TCB of a task and prepares its first
+    context. The task is not inserted in any list.
+
+    \param [in]    *task_body   A pointer to the C function holding the code of the task.
+                    deadline    The deadline of the task
+    \return         the list item of the task or NULL
+ */
+listobj *new_task(void(*task_body)(), uint deadline){
+  //1-Allocate memory for TCB 
+  listobj *pObj = create_listobjRL(deadline); //2-Set deadline in TCB
+  if(pObj==NULL){
+    return NULL;
   }
-  
-  return OK; //5-Return status
+  pObj->pTask->PC =task_body;   //3-Set the TCB's PC to point to the task body
+  pObj->pTask->SP= &(pObj->pTask->StackSeg[STACK_SIZE-1]);//4-Set TCB's SP to point to the stack segment
+  pObj->pTask->SPSR = 0;
+  pObj->pTask->Body = task_body;
+  pObj->pTask->pPart = kernelMode == RUNNING ? Running->pPart : partNew;
+  return pObj;
 }
 
 /** \brief  creates a task.
@@ -103,29 +222,23 @@ exception create_task(void(*task_body)(), uint deadline){
   if(!deadline || (* task_body)==NULL) {
     return FAIL;
   }
-  //1-Allocate memory for TCB 
-  listobj *pObj = create_listobjRL(deadline); //2-Set deadline in TCB
+  listobj *pObj = new_task(task_body, deadline); //1..4-Allocate and set up TCB
   if(pObj==NULL){
     return FAIL;
   }
-  mymem_count_alloc++;    //created memory for listobj
-  mymem_count_alloc++;    //created memory for TCB
-  pObj->pTask->PC =task_body;   //3-Set the TCBs PC to point to the task body
-  pObj->pTask->SP= &(pObj->pTask->StackSeg[STACK_SIZE-1]);//4-Set TCBs SP to point to the stack segment     //newTCB->SP =  &(newTCB->StackSeg[STACK_SIZE-1]);
-  pObj->pTask->SPSR = 0;
   if(kernelMode ==INIT){	//5-IF start-up mode THEN 
-    insertRL(readyL, pObj); //6-Insert new task in Readylist
+    insertRL(READY_LIST(pObj->pTask), pObj); //6-Insert new task in Readylist
     uppdateRunning();
     return OK;//7-Return status
   }//ELSE
   else{
-    set_isr(isr_off); //isr_off();	   //8-Disable interrupts
+    set_isr(ISR_OFF); //isr_off();	   //8-Disable interrupts
+    ISR_ENTER(ISR_SITE_CREATE_TASK);
     SaveContext();  //9-Save context
     if(firstExec){//10-IF first execution THEN
       firstExec=FALSE;//11-Set: not first execution any more
-      insertRL(readyL, pObj);//12-Insert new task in Readylist
-      uppdateRunning();
-      LoadContext();//13-Load context
+      insertRL(READY_LIST(pObj->pTask), pObj);//12-Insert new task in Readylist
+      dispatch();//13-Load context
     }//ENDIF
   }//ENDIF
   return OK;	//14-Return status
@@ -154,21 +267,26 @@ void run( void ){
 
     This call will terminate the running task. All data
     structures for the task will be removed. Thereafter,
-    another task will be scheduled for execution.
+    another task will be scheduled for execution. The next
+    task is chosen, and the CPU time of this one charged, before
+    its TCB is freed, and interrupts stay disabled until the
+    next context is loaded, so nothing is saved to the freed TCB.
 
     \param [in]    none
     \return        none
 */
 void terminate( void ){
+  set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_TERMINATE);
   //1-Remove running task from Readylist
   listobj *temp_obj=extractRL(readyL); 
-  free(temp_obj->pTask);
-  mymem_count_free++;  
-  //free(temp_obj->pMessage);
-  free(temp_obj);
-  mymem_count_free++;
-  uppdateRunning();//2-Set next task to be the running task
-  LoadContext();	//3-Load context
+  TCB *pTask = temp_obj->pTask;
+  drop_call(pTask); //A waiting caller gets FAIL
+  uppdateRunning(); //2-Set next task to be the running task
+  remove_listobj(temp_obj);
+  HEAP_LEAKS_OF(pTask); //Report what the task left behind
+  ISR_EXIT();
+  LoadContext(); //Load context of the next task
 }
 
 
@@ -13,20 +13,28 @@
 #include "kernel.h"
 #include "Listor.h"
 #include "TimerFunctions.h"
+#include "DeferredWork.h"
+#include "KernelCtx.h"
+#include "IsrStats.h"
+#include "CpuStats.h"
+#include "Overload.h"
+#include "Partition.h"
+#include "../kernel_hwdep.h"
 
 /*******************************************************************************
 *                 Task administration Header
 ******************************************************************************/
 	
-extern list  *timmerL;  /**< define timmerL Variable of type list. */
-extern list  *waitingL; /**< define waitingL Variable of type list. */
-extern list  *readyL;   /**< define readyL Variable of type list. */
-extern uint kernelMode; /**< define kernel start up mode Variable  . */       
-extern TCB * Running;   /**< define Running Variable of type TCB  . */ 
-extern uint TC;         /**< define TC (no_of_ticks) Variable  . */ 
+// timmerL, waitingL, readyL, kernelMode, Running and TC are kept in the
+// current kernel instance, see KernelCtx.h
 
 
+kernel_ctx *create_kernel(void);
+void select_kernel(kernel_ctx *pCtx);
 void uppdateRunning();
+void wake_task(listobj *pObj, exception status);
+void dispatch(void);
+listobj *new_task(void(*task_body)(), uint deadline);
 exception init_kernel(void);
 exception create_task(void(*task_body)(), uint deadline);
 void run(void);
@@ -20,6 +20,92 @@
 ******************************************************************************/
 
 #include "TimerFunctions.h"
+#include "Overload.h"
+
+// State of the current kernel instance, see KernelCtx.h
+#define timeBase        (pKernel->timeBase)      /**< timer counts at the start of the current timer period. */
+#define timerInterval   (pKernel->timerInterval) /**< length in counts of the current timer period. */
+#define nextTick        (pKernel->nextTick)      /**< timer counts at which TC is incremented next. */
+#define sliceTicks      (pKernel->sliceTicks)    /**< time slice of equal deadlines, 0 without slicing. */
+#define sliceStart      (pKernel->sliceStart)    /**< TC when the slice of sliceTask started. */
+#define sliceTask       (pKernel->sliceTask)     /**< head of the Readylist at the last tick. */
+#define timerObj        (pKernel->timerObj)      /**< list item of the timer service task. */
+#define timerFirst      (pKernel->timerFirst)    /**< first expired timer whose function has not run. */
+#define timerLast       (pKernel->timerLast)     /**< last expired timer whose function has not run. */
+
+// States of swtimer.nQueued
+#define TIMER_IDLE      0       /**< not queued for the timer service task. */
+#define TIMER_QUEUED    1       /**< queued, its function runs when it is taken. */
+#define TIMER_STOPPED   2       /**< queued, but stopped before its function ran. */
+
+/** \brief  program the timer period
+
+    Programs Timer 0 to interrupt at nWake, or at the next tick if that
+    comes first. Must be called with interrupts disabled.
+
+    \param [in]      nWake: absolute time in timer counts
+    \return          none
+ */
+static void program_timer(utime nWake){
+  uint nCount = timer0_count();
+  if(nWake > nextTick){
+    nWake = nextTick;
+  }
+  if(nWake < timeBase + nCount + TIMER_MIN_COUNTS){//Too close, fire as soon as possible
+    nWake = timeBase + nCount + TIMER_MIN_COUNTS;
+  }
+  timerInterval = (uint)(nWake - timeBase);
+  timer0_set_interval(timerInterval);
+}
+
+/** \brief  return the time base
+
+    Combines the time of the last timer interrupt with the running
+    Timer 0 count. Must be called with interrupts disabled.
+
+    \param [in]      none
+    \return          absolute time in timer counts
+ */
+utime now_counts(void){
+  utime nBase = timeBase;
+  uint nCount = timer0_count();
+  if(timer0_pending()){//The period ended but TimerInt has not run yet
+    nBase += timerInterval;
+    nCount = timer0_count();
+  }
+  return nBase + nCount;
+}
+
+/** \brief  block task until a point in time
+
+    Common part of wait_us() and wait_until().
+
+    \param [in]    nWake:  absolute wake time in timer counts
+    \return        OK/DEADLINE_REACHED
+ */
+static exception sleep_counts(utime nWake){
+  volatile int firstExec = TRUE;
+  int x;
+  exception status = OK;
+  x= set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_WAIT);
+  SaveContext(); //Save context
+  if(firstExec){//IF first execution THEN
+    firstExec=FALSE;
+    readyL->pHead->pNext->nWake = nWake;
+    insertTL(timmerL, extractRL(readyL)); //Place running task in the Timerlist
+    program_timer(timmerL->pHead->pNext->nWake);
+    dispatch();//Load context
+  }//ELSE
+  else{
+    if(DEADLINE_REACHED_AT(Running->DeadLine, TC)){//IF deadline is reached 
+      status=DEADLINE_REACHED;
+    }//ENDIF
+  }//ENDIF
+  ISR_EXIT();
+  set_isr(x);
+  return status;
+}
 
 /** \brief  block task 
 
@@ -35,17 +121,17 @@ exception wait( uint nTicks){
   volatile int firstExec = TRUE;
   int x;
   exception status = OK;
-  x= set_isr(isr_off); //1-Disable interrupt
+  x= set_isr(ISR_OFF); //1-Disable interrupt
+  ISR_ENTER(ISR_SITE_WAIT);
   SaveContext(); //2-Save context
   if(firstExec){//3-IF first execution THEN
     firstExec=FALSE;//4-Set: not first execution any more
-    readyL->pHead->pNext->nTCnt = TC+nTicks;
+    readyL->pHead->pNext->nWake = nextTick + (utime)(nTicks>0 ? nTicks-1 : 0)*TIMER_TICK_COUNTS;
     insertTL(timmerL, extractRL(readyL)); //5-Place running task in the Timerlist
-    uppdateRunning();
-    LoadContext();//6-Load context
+    dispatch();//6-Load context
   }//ELSE
   else{
-    if(Running->DeadLine<=TC){//7-IF deadline is reached 
+    if(DEADLINE_REACHED_AT(Running->DeadLine, TC)){//7-IF deadline is reached 
       status=DEADLINE_REACHED;//8-THEN Status is DEADLINE_REACHED
     }//ELSE
     else{
@@ -53,6 +139,7 @@ exception wait( uint nTicks){
     }//ENDIF
   }//ENDIF
   //9-Return status
+  ISR_EXIT();
   set_isr(x);
   return status;
 }
@@ -67,6 +154,61 @@ exception wait( uint nTicks){
  */
 void set_ticks( uint no_of_ticks ){
      TC=no_of_ticks;  //Set the tick counter.
+     timeBase = (utime)no_of_ticks*TIMER_TICK_COUNTS; //and the time base with it
+     timerInterval = TIMER_TICK_COUNTS;
+     nextTick = timeBase + TIMER_TICK_COUNTS;
+}
+
+/** \brief  return the time
+
+    This call will return the time since the kernel was started,
+    with the resolution of the hardware timer.
+
+    \param [in]    none
+    \return        a 64 bit time in microseconds
+ */
+utime now_us( void ){
+    int x = set_isr(ISR_OFF);
+    utime nNow;
+    ISR_ENTER(ISR_SITE_TIMER);
+    nNow = now_counts();
+    ISR_EXIT();
+    set_isr(x);
+    return COUNTS_TO_US(nNow);
+}
+
+/** \brief  block task for a number of microseconds
+
+    This call will block the calling task for the given time. The
+    timer is programmed for the exact wake time so the task is not
+    rounded up to a whole tick.
+
+    \param [in]    nMicros:  the duration given in microseconds
+    \return        OK: Normal function, no exception occurred.
+    \return        DEADLINE_REACHED: the deadline of the task was reached.
+ */
+exception wait_us( uint nMicros ){
+    int x = set_isr(ISR_OFF);
+    utime nWake;
+    ISR_ENTER(ISR_SITE_WAIT);
+    nWake = now_counts() + US_TO_COUNTS(nMicros);
+    ISR_EXIT();
+    set_isr(x);
+    return sleep_counts(nWake);
+}
+
+/** \brief  block task until a point in time
+
+    This call will block the calling task until the given absolute
+    time, see now_us(). A time in the past returns at once after a
+    new scheduling.
+
+    \param [in]    nMicros:  the absolute wake time in microseconds
+    \return        OK: Normal function, no exception occurred.
+    \return        DEADLINE_REACHED: the deadline of the task was reached.
+ */
+exception wait_until( utime nMicros ){
+    return sleep_counts(US_TO_COUNTS(nMicros));
 }
 
 /** \brief  return the TC
@@ -93,6 +235,18 @@ uint deadline( void ){
     return Running->DeadLine; //Return the deadline of the current task
 }
 
+/** \brief  return the task deadline tick as a time
+
+    Deadlines are kept in ticks, this is the time of the deadline
+    tick and not a time given to set_deadline_tick_us.
+
+    \param [in]    none
+    \return        the deadline of the calling task in microseconds, see now_us()
+ */
+utime deadline_tick_us( void ){
+    return COUNTS_TO_US((utime)Running->DeadLine*TIMER_TICK_COUNTS);
+}
+
 /** \brief  seting new deadline for the task
 
     This call will set the deadline for the calling task. The
@@ -105,18 +259,369 @@ uint deadline( void ){
  */
 void set_deadline( uint nDeadline ){
      volatile int firstExec = TRUE;
-     set_isr(isr_off); //Disable interrupt
+     set_isr(ISR_OFF); //Disable interrupt
+     ISR_ENTER(ISR_SITE_SET_DEADLINE);
      SaveContext(); //Save context
      if(firstExec){//IF first execution THEN
        firstExec=FALSE;//Set: not first execution any more
        Running->DeadLine = nDeadline; //Set the deadline field in the calling TCB.
        insertRL(readyL, extractRL(readyL));//Reschedule Readylist
-       uppdateRunning();
-       LoadContext();//Load context
+       dispatch();//Load context
      }//ENDIF
 }
 
+/** \brief  seting new deadline for the task as a time
+
+    Deadlines are kept in ticks, the deadline is set to the
+    first tick at or after the given time. It is reached at that
+    tick, up to one tick after nMicros, and it orders the task
+    like any other deadline on that tick.
+
+    \param [in]    nMicros: the new deadline in microseconds, see now_us().
+    \return        none
+ */
+void set_deadline_tick_us( utime nMicros ){
+     utime nCounts = US_TO_COUNTS(nMicros);
+     set_deadline((uint)((nCounts + TIMER_TICK_COUNTS - 1)/TIMER_TICK_COUNTS));
+}
+
+
+
+/** \brief  expiry of a timeout
+
+    A call that may block several times computes its expiry once, so
+    the timeout covers the whole call. Must be called with interrupts
+    disabled.
+
+    \param [in]      nMicros: the timeout in microseconds, 0 for none
+    \return          the expiry in timer counts, 0 for none
+ */
+utime timeout_at(uint nMicros){
+  return nMicros > 0 ? now_counts() + US_TO_COUNTS(nMicros) : 0;
+}
+
+/** \brief  start the timeout of a timed wait
+
+    Puts a timeout entry for the task in the Timerlist, next to its
+    place in a Waitinglist. The entry is allocated on the first timed
+    wait of the task and kept until it terminates. Must be called with
+    interrupts disabled.
+
+    \param [in]      pObj:    the list item of the task about to block
+    \param [in]      nExpiry: the expiry in timer counts, see timeout_at()
+    \return          FAIL/OK: FAIL if the entry could not be allocated
+ */
+exception start_timeout(listobj *pObj, utime nExpiry){
+  if(pObj->pTimeout == NULL){
+    pObj->pTimeout = create_listobjTL();
+    if(pObj->pTimeout == NULL){
+      return FAIL;
+    }
+    pObj->pTimeout->pOwner = pObj;
+  }
+  pObj->pTimeout->nWake = nExpiry;
+  insertTL(timmerL, pObj->pTimeout);
+  program_timer(timmerL->pHead->pNext->nWake);
+  return OK;
+}
+
+/** \brief  cancel the timeout of a timed wait
+
+    Removes the timeout entry of the task from the Timerlist in
+    constant time, if it is there. Must be called with interrupts
+    disabled.
+
+    \param [in]      pObj: the list item of the task
+    \return          none
+ */
+void cancel_timeout(listobj *pObj){
+  if(pObj->pTimeout != NULL && pObj->pTimeout->pNext != NULL){
+    extractWL(timmerL, pObj->pTimeout);
+  }
+}
+
+/** \brief  timer service task
+
+    Runs the functions of the expired software timers in expiry order
+    with interrupts enabled. When none is left it waits without a
+    deadline in the Waitinglist until the tick work queues the next.
+
+    \param [in]      none
+    \return          none
+ */
+static void timer_service(void){
+  volatile int firstExec;
+  swtimer *pTimer;
+  uint nState;
+  int x;
+  while(1){
+    x = set_isr(ISR_OFF); //Disable interrupt
+    ISR_ENTER(ISR_SITE_TIMER);
+    pTimer = timerFirst;
+    if(pTimer != NULL){
+      timerFirst = pTimer->pNextExpired;
+      if(timerFirst == NULL){
+        timerLast = NULL;
+      }
+      nState = pTimer->nQueued;
+      pTimer->nQueued = TIMER_IDLE;
+      ISR_EXIT();
+      set_isr(x);
+      if(nState == TIMER_QUEUED){
+        pTimer->pFunc(pTimer->pArg);
+      }
+    }
+    else{
+      firstExec = TRUE;
+      SaveContext(); //Save context
+      if(firstExec){//Wait for the next expiry
+        firstExec = FALSE;
+        timerObj->pTask->DeadLine = NO_DEADLINE;
+        insertRL(waitingL, extractWL(readyL, timerObj));
+        dispatch();//Load context
+      }
+      ISR_EXIT();
+      set_isr(x);
+    }
+  }
+}
+
+/** \brief  set up a software timer
+
+    A software timer is an entry of the Timerlist. Its function is run
+    by the timer service task, a task shared by all software timers
+    that gets a deadline TIMER_SERVICE_TICKS ticks after an expiry, so
+    the functions compete with the tasks by deadline and do not delay
+    the tick work. A function may make the _no_wait calls, publish,
+    post_work and the timer calls. A function that blocks or waits
+    delays the functions of all other timers. The first call creates
+    the timer service task and must be made in start up mode after
+    init_kernel.
+
+    \param [in]    pTimer: the timer, owned by the caller.
+    \param [in]    pFunc: the function run when the timer expires.
+    \param [in]    pArg: the argument of pFunc.
+    \return        FAIL/OK: FAIL when the timer service task cannot be
+                            created, pTimer can not be started then.
+ */
+exception init_timer( swtimer* pTimer, void (*pFunc)(void *pArg), void *pArg ){
+  pTimer->Entry.pTask = NULL;
+  pTimer->Entry.pOwner = NULL;
+  pTimer->Entry.pPrevious = NULL;
+  pTimer->Entry.pNext = NULL;
+  pTimer->pFunc = NULL;
+  pTimer->pArg = pArg;
+  pTimer->nTicks = 0;
+  pTimer->nPeriod = 0;
+  pTimer->nQueued = TIMER_IDLE;
+  pTimer->pNextExpired = NULL;
+  if(timerObj == NULL){
+    if(kernelMode == RUNNING){
+      return FAIL;
+    }
+    timerObj = new_task(timer_service, NO_DEADLINE);
+    if(timerObj == NULL){
+      return FAIL;
+    }
+    timerObj->pTask->pPart = NULL;
+    timerObj->pTask->Policy = MISS_KERNEL;
+    insertRL(waitingL, timerObj); //Until the first expiry
+  }
+  pTimer->pFunc = pFunc;
+  return OK;
+}
+
+/** \brief  start a software timer
+
+    The timer expires nTicks ticks from now as wait() does, then every
+    nPeriod ticks. A timer that runs already is started again. Can be
+    called from tasks, from timer functions and in start up mode.
+
+    \param [in]    pTimer: the timer.
+    \param [in]    nTicks: the ticks until it expires, at least 1.
+    \param [in]    nPeriod: the reload interval in ticks, 0 for one-shot.
+    \return        FAIL/OK: FAIL for no ticks or a timer without function
+ */
+exception start_timer( swtimer* pTimer, uint nTicks, uint nPeriod ){
+  int x;
+  if(nTicks == 0 || pTimer->pFunc == NULL){
+    return FAIL;
+  }
+  x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_TIMER);
+  if(pTimer->Entry.pNext != NULL){
+    extractWL(timmerL, &pTimer->Entry);
+  }
+  pTimer->nTicks = nTicks;
+  pTimer->nPeriod = nPeriod;
+  pTimer->Entry.nWake = nextTick + (utime)(nTicks-1)*TIMER_TICK_COUNTS; //On a tick, no timer to program
+  insertTL(timmerL, &pTimer->Entry);
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  start a software timer again
+
+    \param [in]    pTimer: the timer.
+    \return        FAIL/OK: FAIL if the timer was never started
+ */
+exception reset_timer( swtimer* pTimer ){
+  return start_timer(pTimer, pTimer->nTicks, pTimer->nPeriod);
+}
+
+/** \brief  stop a software timer
+
+    The timer is taken out of the Timerlist in constant time, stopping
+    a timer that does not run does nothing. A function that expired
+    but was not run yet by the timer service task is not run.
+
+    \param [in]    pTimer: the timer.
+    \return        none
+ */
+void stop_timer( swtimer* pTimer ){
+  int x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_TIMER);
+  if(pTimer->Entry.pNext != NULL){
+    extractWL(timmerL, &pTimer->Entry);
+  }
+  if(pTimer->nQueued == TIMER_QUEUED){
+    pTimer->nQueued = TIMER_STOPPED;
+  }
+  ISR_EXIT();
+  set_isr(x);
+}
+
+/** \brief  queue an expired software timer
 
+    Called by the tick work with the timer taken out of the Timerlist.
+    An auto-reload timer is put back first, periods that have passed
+    already are skipped. The timer is queued for the timer service
+    task, an expiry while it is queued already runs its function once.
+
+    \param [in]      pTimer: the timer
+    \param [in]      nNow: now_counts() of the tick work
+    \return          none
+ */
+static void timer_expired(swtimer *pTimer, utime nNow){
+  if(pTimer->nPeriod > 0){
+    do{
+      pTimer->Entry.nWake += (utime)pTimer->nPeriod*TIMER_TICK_COUNTS;
+    }while(pTimer->Entry.nWake <= nNow);
+    insertTL(timmerL, &pTimer->Entry);
+  }
+  if(pTimer->nQueued == TIMER_IDLE){
+    pTimer->pNextExpired = NULL;
+    if(timerLast != NULL){
+      timerLast->pNextExpired = pTimer;
+    }
+    else{
+      timerFirst = pTimer;
+    }
+    timerLast = pTimer;
+  }
+  pTimer->nQueued = TIMER_QUEUED;
+}
+
+/** \brief  set the time slice of tasks with equal deadlines
+
+    Ready tasks with the same DeadLine as the head of the Readylist
+    take turns, the head is moved behind them after nTicks ticks.
+    Without a time slice a task keeps the CPU until it blocks.
+
+    \param [in]    nTicks: the time slice in ticks, 0 turns slicing off
+    \return        none
+ */
+void set_time_slice( uint nTicks ){
+  int x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_TIMER);
+  sliceTicks = nTicks;
+  sliceTask = NULL;
+  ISR_EXIT();
+  set_isr(x);
+}
+
+/** \brief  rotate the tasks with the deadline of the head
+
+    Called by the tick work. A head whose time slice is used up is put
+    after the other ready tasks with its DeadLine by insertRL.
+
+    \param [in]      none
+    \return          none
+ */
+static void slice_check(void){
+  listobj *pHead = readyL->pHead->pNext;
+  if(sliceTicks == 0){
+    return;
+  }
+  if(pHead->pTask != sliceTask){
+    sliceTask = pHead->pTask;
+    sliceStart = TC;
+  }
+  else if(TC - sliceStart >= sliceTicks){
+    if(pHead->pNext != readyL->pTail && pHead->pNext->pTask->DeadLine == pHead->pTask->DeadLine){
+      insertRL(readyL, extractRL(readyL));
+      sliceTask = readyL->pHead->pNext->pTask;
+    }
+    sliceStart = TC;
+  }
+}
+
+/** \brief  tick work
+
+    This function is not available for the user to call.
+    Deferred part of the tick, run by the work context. Both lists are
+    sorted (Timerlist on nWake, Waitinglist on DeadLine) so only the
+    expired entries at the head are visited. Expired software timers
+    are queued and the timer service task is woken to run them.
+
+    \param [in]      none
+    \return          none
+ */
+void tick_work(void){
+  int x;
+  utime nNow;
+  x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_TICK_WORK);
+  nNow = now_counts();
+  ISR_EXIT();
+  set_isr(x);
+  //Move tasks that are ready for execution from the Timerlist to Readylist
+  while(timmerL->pHead->pNext != timmerL->pTail && timmerL->pHead->pNext->nWake<=nNow){
+    if(timmerL->pHead->pNext->pOwner != NULL){//Timeout of a timed wait
+      wake_task(timmerL->pHead->pNext->pOwner, TIMEOUT);
+    }
+    else if(timmerL->pHead->pNext->pTask == NULL){//Software timer
+      timer_expired((swtimer *)extractRL(timmerL), nNow);
+    }
+    else{
+      miss_restore(timmerL->pHead->pNext->pTask);
+      insertRL(READY_LIST(timmerL->pHead->pNext->pTask),extractRL(timmerL));
+    }
+  }
+  if(timerFirst != NULL && timerObj->pTask->DeadLine == NO_DEADLINE){//Wake the timer service task
+    timerObj->pTask->DeadLine = TC + TIMER_SERVICE_TICKS;
+    insertRL(READY_LIST(timerObj->pTask), extractWL(waitingL, timerObj));
+  }
+  if(timmerL->pHead->pNext != timmerL->pTail){//Program the exact next wake time
+    x = set_isr(ISR_OFF);
+    ISR_ENTER(ISR_SITE_TICK_WORK);
+    program_timer(timmerL->pHead->pNext->nWake);
+    ISR_EXIT();
+    set_isr(x);
+  }
+  //Move tasks that have expired deadlines from the Waitinglist to Readylist,
+  //their Mailbox entry is cleaned up by the task itself.
+  while(waitingL->pHead->pNext != waitingL->pTail && DEADLINE_REACHED_AT(waitingL->pHead->pNext->pTask->DeadLine, TC)){
+    wake_task(waitingL->pHead->pNext, DEADLINE_REACHED);
+  }
+  //Apply the overload policies of the tasks that missed their deadline
+  miss_check();
+  //Round robin among the tasks with the deadline of the head
+  slice_check();
+  //Lite tasks test their LT_WAIT_UNTIL condition again
+  lite_tick();
+}
 
 /** \brief  Interrupt Service Routine
 
@@ -124,45 +629,57 @@ void set_deadline( uint nDeadline ){
     It is called by an ISR (Interrupt Service Routine)
     invoked every tick. Note, context is automatically saved
     prior to call and automatically loaded on function exit.
+    With KERNEL_PC_SAMPLES the saved PC of Running is sampled first.
+    The interrupt part only counts the tick and posts the list
+    work. The return from the interrupt is a scheduling point,
+    so the work context is switched in to run it unless it is
+    running already.
 
     \param [in]      none
     \return          none
  */
 void TimerInt(void)
 {
-  TC++;//Increment tick counter
-  //Check the Timerlist for tasks that are ready for execution, move these to Readylist
-  //pekare
-  listobj *pTobj = timmerL->pHead;
-  while(pTobj->pNext != timmerL->pTail){
-    if(pTobj->pNext->nTCnt<=TC){
-      insertRL(readyL,extractRL(timmerL));//timmerL->pHead->pNext
-      uppdateRunning();
-    }
-    pTobj=pTobj->pNext;
-  }
-  //Check the Waitinglist for tasks that have expired deadlines,
-  //move these to Readylist and clean up their Mailbox entry.
-  listobj *pWobj = waitingL->pHead;
-  while(pWobj->pNext != waitingL->pTail){
-    if(pWobj->pNext->pTask->DeadLine <=TC){
-      insertRL(readyL,extractWL(waitingL,waitingL->pHead->pNext));  //waitingL->pHead->pNext
-      uppdateRunning();
-    }
-    pWobj=pWobj->pNext;
+  ISR_ENTER(ISR_SITE_TIMER_INT);
+  PC_SAMPLE();
+  timeBase += timerInterval;
+  if(timeBase >= nextTick){//The period ended on a tick
+    TC++;//Increment tick counter
+    nextTick += TIMER_TICK_COUNTS;
+    cyclic_tick();//Start the slot of the cyclic schedule
+    partition_tick();//Charge the budget of the partition
+  }
+  program_timer(nextTick);//tick_work shortens the period for a timed wake
+  post_tick();//Runs tick_work, needs no slot of the work queue
+  if(!kernelDraining){ //Return from interrupt is a scheduling point
+    uppdateRunning();
   }
+  ISR_EXIT();
 }
 /** \brief  idle task
 
-    This function let the task stay in while loop untill its something happen
+    This function let the task stay in while loop untill its something happen.
+    Work posted by interrupt handlers is handed to the work context here,
+    otherwise freed kernel objects are given back to the heap one at a time.
 
     \param [in]      none
     \return          none
  */
 void Idle(void){
+    volatile int firstExec;
     while(1){
-       /* SaveContext();
-        TimerInt();
-        LoadContext();*/
+      if(pending_work()){
+        firstExec = TRUE;
+        set_isr(ISR_OFF); //Disable interrupt
+        ISR_ENTER(ISR_SITE_IDLE);
+        SaveContext(); //Save context
+        if(firstExec){
+          firstExec=FALSE;
+          dispatch();
+        }
+      }
+      else{
+        kmem_reclaim();
+      }
   }
 }
\ No newline at end of file
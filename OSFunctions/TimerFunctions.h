@@ -12,13 +12,39 @@
 #include "kernel.h"
 #include "Listor.h"
 #include "TaskAdministration.h"
+#include "PcSample.h"
+#include "Cyclic.h"
+#include "Lite.h"
+
+#define US_TO_COUNTS(us)     (((utime)(us)*1000 + TIMER_COUNT_NS-1)/TIMER_COUNT_NS) /**< rounded up. */
+#define COUNTS_TO_US(c)      ((utime)(c)*TIMER_COUNT_NS/1000)
+
+#ifndef TIMER_SERVICE_TICKS
+#define TIMER_SERVICE_TICKS  1  /**< deadline of the timer service task, ticks after an expiry. */
+#endif
 
 exception wait(uint nTicks);
+exception wait_us(uint nMicros);
+exception wait_until(utime nMicros);
 void set_ticks(uint no_of_ticks);
 uint ticks(void);
+utime now_us(void);
 uint deadline(void);
+utime deadline_tick_us(void);
 void set_deadline(uint nDeadline);
+void set_deadline_tick_us(utime nMicros);
+void set_time_slice(uint nTicks);
+exception init_timer(swtimer* pTimer, void (*pFunc)(void *pArg), void *pArg);
+exception start_timer(swtimer* pTimer, uint nTicks, uint nPeriod);
+exception reset_timer(swtimer* pTimer);
+void stop_timer(swtimer* pTimer);
+
+utime now_counts(void);
+utime timeout_at(uint nMicros);
+exception start_timeout(listobj *pObj, utime nExpiry);
+void cancel_timeout(listobj *pObj);
 
+void tick_work(void);
 void TimerInt(void);
 void Idle(void);
 
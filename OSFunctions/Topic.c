@@ -0,0 +1,305 @@
+/**************************************************************************//**
+ * @file     Topic.c
+ * @brief    ART Real Time Micro Kernel Topic.c File
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Hussam Alshammari is supplying this software for use with Cortex-M
+ * processor based microcontrollers.  This file have Task administration
+ * Inter-Process Communication and Timing functions that will work with ARM based processors.
+ *
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+*                 Publish/subscribe topics
+******************************************************************************/
+
+#include <string.h>
+#include "Topic.h"
+
+/** \brief  drop a reference to a payload
+
+    Frees the payload when it was the last reference. Must be called
+    with interrupts disabled.
+
+    \param [in]      pLoad: the payload
+    \return          none
+ */
+static void drop_ref(payload *pLoad){
+  pLoad->nRef--;
+  if(pLoad->nRef == 0){
+    kmem_free(KOBJ_DATA, pLoad);
+  }
+}
+
+/** \brief  take the oldest reference of a subscriber
+
+    The reference is handed over to the caller. Must be called with
+    interrupts disabled and nCount > 0.
+
+    \param [in]      pSub: the subscriber
+    \return          the data of the payload
+ */
+static void *take_head(subscriber *pSub){
+  payload *pLoad = pSub->pQueue[pSub->nFirst];
+  pSub->nFirst = (pSub->nFirst + 1) % pSub->nMax;
+  pSub->nCount--;
+  return pLoad + 1;
+}
+
+/** \brief  create a topic
+
+    \param [in]    nDataSize: the size of the data of one publication.
+    \return        topic*: a pointer to the created topic or NULL.
+ */
+topic* create_topic( uint nDataSize ){
+  topic *pTopic = (topic *)kmem_alloc(KOBJ_TOPIC, sizeof(topic));
+  if(pTopic == NULL){
+    return NULL;
+  }
+  HEAP_OWNER(pTopic, pTopic); //The topic is not a leak of its creator
+  pTopic->nDataSize = nDataSize;
+  return pTopic;
+}
+
+/** \brief  remove a topic
+
+    \param [in]    pTopic: the topic.
+    \return        OK: The topic was removed
+    \return        NOT_EMPTY: The topic still has subscribers.
+ */
+exception remove_topic( topic* pTopic ){
+  if(pTopic->pFirst != NULL){
+    return NOT_EMPTY;
+  }
+  kmem_free(KOBJ_TOPIC, pTopic);
+  return OK;
+}
+
+/** \brief  subscribe to a topic
+
+    The subscriber keeps up to nQueue publications it has not taken,
+    when the queue is full the oldest one is dropped. A queue of
+    TOPIC_LATEST keeps the latest value only.
+
+    \param [in]    pTopic: the topic.
+    \param [in]    nQueue: number of publications kept, at least 1.
+    \return        subscriber*: the subscription or NULL.
+ */
+subscriber* subscribe( topic* pTopic, uint nQueue ){
+  int x;
+  subscriber *pSub;
+  if(nQueue == 0){
+    return NULL;
+  }
+  x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_TOPIC);
+  pSub = (subscriber *)kmem_alloc(KOBJ_SUBSCRIBER, sizeof(subscriber));
+  if(pSub == NULL){
+    ISR_EXIT();
+    set_isr(x);
+    return NULL;
+  }
+  pSub->pQueue = (payload **)kmem_alloc(KOBJ_DATA, nQueue * sizeof(payload *));
+  if(pSub->pQueue == NULL){
+    kmem_free(KOBJ_SUBSCRIBER, pSub);
+    ISR_EXIT();
+    set_isr(x);
+    return NULL;
+  }
+  HEAP_OWNER(pSub, pSub); //The subscription and its queue own themselves
+  HEAP_OWNER(pSub->pQueue, pSub);
+  pSub->pTopic = pTopic;
+  pSub->nMax = nQueue;
+  pSub->nFirst = 0;
+  pSub->nCount = 0;
+  pSub->pWaiter = NULL;
+  pSub->pNext = pTopic->pFirst;
+  pTopic->pFirst = pSub;
+  ISR_EXIT();
+  set_isr(x);
+  return pSub;
+}
+
+/** \brief  end a subscription
+
+    Releases the publications the subscriber has not taken. Payloads
+    already taken stay valid until they are released.
+
+    \param [in]    pSub: the subscription.
+    \return        OK/FAIL: FAIL if a task is blocked on the subscription.
+ */
+exception unsubscribe( subscriber* pSub ){
+  subscriber **ppSub;
+  int x = set_isr(ISR_OFF);
+  ISR_ENTER(ISR_SITE_TOPIC);
+  if(pSub->pWaiter != NULL){
+    ISR_EXIT();
+    set_isr(x);
+    return FAIL;
+  }
+  for(ppSub = &pSub->pTopic->pFirst; *ppSub != pSub; ppSub = &(*ppSub)->pNext){
+  }
+  *ppSub = pSub->pNext;
+  while(pSub->nCount > 0){
+    drop_ref((payload *)take_head(pSub) - 1);
+  }
+  kmem_free(KOBJ_DATA, pSub->pQueue);
+  kmem_free(KOBJ_SUBSCRIBER, pSub);
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  publish to a topic
+
+    The data is copied once into a shared payload and a reference is
+    queued at every subscriber, within one critical section. Tasks
+    blocked in take_wait are moved to the Readylist, which might
+    lead to a context switch.
+
+    \param [in]    pTopic: the topic.
+    \param [in]    pData: the data, nDataSize bytes of the topic.
+    \return        FAIL/OK: FAIL if no payload could be allocated.
+ */
+exception publish( topic* pTopic, void* pData ){
+  volatile int firstExec = TRUE;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_PUBLISH);
+  SaveContext(); //Save context
+  if(firstExec){
+    firstExec = FALSE;
+    if(pTopic->pFirst != NULL){
+      int woken = FALSE;
+      subscriber *pSub;
+      payload *pLoad = (payload *)kmem_alloc(KOBJ_DATA, sizeof(payload) + pTopic->nDataSize);
+      if(pLoad == NULL){
+        ISR_EXIT();
+        set_isr(x);
+        return FAIL;
+      }
+      HEAP_OWNER(pLoad, pTopic); //Shared by the subscribers, not the publisher
+      memcpy(pLoad + 1, pData, pTopic->nDataSize);
+      pLoad->nRef = 0;
+      for(pSub = pTopic->pFirst; pSub != NULL; pSub = pSub->pNext){
+        if(pSub->nCount == pSub->nMax){//Drop the oldest publication
+          drop_ref((payload *)take_head(pSub) - 1);
+        }
+        pSub->pQueue[(pSub->nFirst + pSub->nCount) % pSub->nMax] = pLoad;
+        pSub->nCount++;
+        pLoad->nRef++;
+        //Move the receiving task to Readylist, unless its deadline woke it already,
+        //then it is in the Readylist and clears pWaiter itself when it resumes
+        if(pSub->pWaiter != NULL && pSub->pWaiter->Status == OK){
+          wake_task(pSub->pWaiter, OK);
+          pSub->pWaiter = NULL;
+          woken = TRUE;
+        }
+      }
+      if(woken){
+        dispatch();//Load context
+      }
+    }
+  }
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  take a publication, block until there is one
+
+    The oldest publication the subscriber has not taken is returned in
+    *ppData. The payload is shared with the other subscribers and must
+    not be written, it is given back with release_payload. During the
+    blocking period the deadline of the task might be reached.
+
+    \param [in]    pSub: the subscription.
+    \param [out]   ppData: the data of the publication.
+    \return        OK: Normal function, no exception occurred.
+    \return        FAIL: another task is blocked on the subscription.
+    \return        DEADLINE_REACHED: the deadline of the task is reached.
+ */
+exception take_wait( subscriber* pSub, void** ppData ){
+  volatile int firstExec = TRUE;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_TAKE);
+  SaveContext(); //Save context
+  if(firstExec){
+    firstExec = FALSE;
+    if(pSub->nCount == 0){//Block until the next publication
+      if(pSub->pWaiter != NULL){
+        ISR_EXIT();
+        set_isr(x);
+        return FAIL;
+      }
+      readyL->pHead->pNext->Status = OK;
+      pSub->pWaiter = readyL->pHead->pNext;
+      insertRL(waitingL, extractRL(readyL));
+      dispatch();//Load context
+    }
+  }
+  else{
+    x = set_isr(ISR_OFF); //Disable interrupt
+    ISR_ENTER(ISR_SITE_TAKE);
+    if(readyL->pHead->pNext->Status != OK){//IF deadline is reached THEN
+      exception status = readyL->pHead->pNext->Status;
+      readyL->pHead->pNext->Status = OK;
+      pSub->pWaiter = NULL;
+      miss_resume(); //Abort the job if that is its overload policy
+      ISR_EXIT();
+      set_isr(x);
+      return status;
+    }
+  }
+  if(pSub->nCount == 0){//Taken by another task sharing the subscription
+    ISR_EXIT();
+    set_isr(x);
+    return FAIL;
+  }
+  *ppData = take_head(pSub);
+  ISR_EXIT();
+  set_isr(x);
+  return OK;
+}
+
+/** \brief  take a publication if there is one
+
+    As take_wait, but returns FAIL at once when the subscriber has
+    no publication.
+
+    \param [in]    pSub: the subscription.
+    \param [out]   ppData: the data of the publication.
+    \return        OK/FAIL  Integer indicating whether or not a publication was taken.
+ */
+int take_no_wait( subscriber* pSub, void** ppData ){
+  int status = FAIL;
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_TAKE);
+  if(pSub->nCount > 0){
+    *ppData = take_head(pSub);
+    status = OK;
+  }
+  ISR_EXIT();
+  set_isr(x);
+  return status;
+}
+
+/** \brief  release a taken publication
+
+    The payload is recycled when the last subscriber has released it.
+
+    \param [in]    pData: the data returned by take_wait or take_no_wait.
+    \return        none
+ */
+void release_payload( void* pData ){
+  int x = set_isr(ISR_OFF); //Disable interrupt
+  ISR_ENTER(ISR_SITE_TOPIC);
+  drop_ref((payload *)pData - 1);
+  ISR_EXIT();
+  set_isr(x);
+}
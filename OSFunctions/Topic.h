@@ -0,0 +1,52 @@
+/**
+ * @file Topic.h 
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief File containing the publish/subscribe topics.
+ *
+ * A publisher copies its data once into a shared payload and every
+ * subscriber of the topic gets a reference to it. The payload is freed
+ * when the last reference is released.
+ */
+
+#ifndef Topic_H
+#define Topic_H
+#include "kernel.h"
+#include "Listor.h"
+#include "TaskAdministration.h"
+
+// Shared payload, the data follows the header which is sized to keep
+// it aligned for any type
+typedef union {
+  uint          nRef;           // References held by subscribers and receivers
+  utime         nAlign;
+  void          *pAlign;
+} payload;
+
+// Subscription of one receiver to a topic
+struct subobj {
+  struct topicobj *pTopic;
+  struct subobj   *pNext;       // Next subscriber of the topic
+  listobj         *pWaiter;     // Task blocked in take_wait
+  payload         **pQueue;     // nMax references, oldest at nFirst
+  uint            nMax;
+  uint            nFirst;
+  uint            nCount;
+};
+
+// Topic
+struct topicobj {
+  uint            nDataSize;
+  struct subobj   *pFirst;      // Subscribers
+};
+
+topic* create_topic( uint nDataSize );
+exception remove_topic( topic* pTopic );
+subscriber* subscribe( topic* pTopic, uint nQueue );
+exception unsubscribe( subscriber* pSub );
+exception publish( topic* pTopic, void* pData );
+exception take_wait( subscriber* pSub, void** ppData );
+int take_no_wait( subscriber* pSub, void** ppData );
+void release_payload( void* pData );
+
+#endif
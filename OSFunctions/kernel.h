@@ -6,6 +6,21 @@
 // Debug option
 //#define       _DEBUG
 
+// Measure interrupts-disabled time per kernel call, see IsrStats.h
+//#define       KERNEL_ISR_STATS
+
+// Account heap usage per call site and report leaks, see HeapStats.h
+//#define       KERNEL_HEAP_STATS
+
+// Stamp Messages and record their latency per Mailbox, see MsgStats.h
+//#define       KERNEL_MSG_STATS
+
+// Sample the interrupted PC and task every tick, see PcSample.h
+//#define       KERNEL_PC_SAMPLES
+
+// Heap-free kernel, objects come from pools sized in KernelMem.h
+//#define       KERNEL_STATIC
+
 /*********************************************************/
 /** Global variabels and definitions                     */
 /*********************************************************/
@@ -13,6 +28,10 @@
 #include <stdlib.h>
 #include <limits.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #ifdef texas_dsp
 
 #define CONTEXT_SIZE    34-2 
@@ -34,15 +53,38 @@
 #define OK              1
 
 #define DEADLINE_REACHED        0
+#define TIMEOUT                 2
 #define NOT_EMPTY               0
 
 #define SENDER          +1
 #define RECEIVER        -1
 
+#define NO_DEADLINE     UINT_MAX
+#define BACKGROUND      (UINT_MAX-1)    // After all deadlines, before NO_DEADLINE
+
+// Overload policies applied when a task misses its deadline
+#define MISS_NONE       0       // Blocking calls return DEADLINE_REACHED
+#define MISS_ABORT      1       // Restart the body one period later, or terminate
+#define MISS_SKIP       2       // Continue with the deadline of the next period
+#define MISS_DEMOTE     3       // Continue in the background until the next period
+#define MISS_HANDLER    4       // Call the miss handler
+#define MISS_POLICIES   5
+
+// Wrap-safe deadline compare on the tick counter, BACKGROUND and
+// NO_DEADLINE are never reached and come after all other deadlines
+#define DEADLINE_RANK(d)            ((d) >= BACKGROUND ? (d) - BACKGROUND + 1 : 0)
+#define DEADLINE_REACHED_AT(d, now) (DEADLINE_RANK(d) == 0 && (int)((now) - (d)) >= 0)
+#define DEADLINE_BEFORE(a, b)       (DEADLINE_RANK(a) != DEADLINE_RANK(b) ? \
+                                     DEADLINE_RANK(a) < DEADLINE_RANK(b) : \
+                                     DEADLINE_RANK(a) == 0 && (int)((a) - (b)) < 0)
+
 
 typedef int             exception;
+#ifndef __cplusplus
 typedef int             bool;
+#endif
 typedef unsigned int    uint;
+typedef unsigned long long utime;
 typedef int 		action;
 
 struct  l_obj;         // Forward declaration
@@ -56,6 +98,21 @@ typedef struct
 	uint	Context[CONTEXT_SIZE];
 	uint	StackSeg[STACK_SIZE];
 	uint	DeadLine;
+	void	(*Body)();		// Task body, for reports
+	uint	nWindow;		// Load window of nCpu and nSwitches
+	uint	nCpu;			// Timer counts run in the window
+	uint	nSwitches;		// Times switched in during the window
+	uint	nPrevCpu;		// nCpu of the window before
+	uint	nPrevSwitches;		// nSwitches of the window before
+	uint	Policy;			// Overload policy on a deadline miss
+	uint	nPeriod;		// Period of MISS_SKIP and MISS_ABORT
+	void	(*pMiss)(void *pTask);	// Handler of MISS_HANDLER
+	uint	nMissDeadLine;		// Deadline whose miss was handled
+	uint	bAbort;			// Abort once out of its blocking call
+	uint	bWoken;			// Woken in a blocking call and not run since
+	uint	nOrigin;		// Origin stamp of the last received Message
+	struct msgobj	*pCall;		// Call received and not replied yet
+	struct partobj	*pPart;		// Time partition, NULL outside of all
 } TCB;
 #else
 typedef struct
@@ -66,51 +123,185 @@ typedef struct
 	uint    SPSR;
 	uint    StackSeg[STACK_SIZE];
 	uint    DeadLine;
+	void    (*Body)();      // Task body, for reports
+	uint    nWindow;        // Load window of nCpu and nSwitches
+	uint    nCpu;           // Timer counts run in the window
+	uint    nSwitches;      // Times switched in during the window
+	uint    nPrevCpu;       // nCpu of the window before
+	uint    nPrevSwitches;  // nSwitches of the window before
+	uint    Policy;         // Overload policy on a deadline miss
+	uint    nPeriod;        // Period of MISS_SKIP and MISS_ABORT
+	void    (*pMiss)(void *pTask); // Handler of MISS_HANDLER
+	uint    nMissDeadLine;  // Deadline whose miss was handled
+	uint    bAbort;         // Abort once out of its blocking call
+	uint    bWoken;         // Woken in a blocking call and not run since
+	uint    nOrigin;        // Origin stamp of the last received Message
+	struct msgobj *pCall;   // Call received and not replied yet
+	struct partobj *pPart;  // Time partition, NULL outside of all
 } TCB;
 #endif
 
+// Load of one task over the last CPU_WINDOW_TICKS, see cpu_top()
+typedef struct {
+	TCB             *pTask;
+	void            (*Body)();
+	uint            nLoad;          // CPU time in 1/1000
+	uint            nSwitches;      // Times the task was switched in
+} taskload;
+
 // Message items
 typedef struct msgobj {
 	char            *pData;
+	uint            nSize;          // Length of the data
+	uint            *pSize;         // Length of a blocked receiver, set by the sender
+	uint            nStamp;         // timer0_stamp() when it was sent
+	uint            nOrigin;        // timer0_stamp() when its chain started
+	void            *pReply;        // Reply buffer of a call, NULL otherwise
 	exception       Status;
 	struct l_obj    *pBlock;
 	struct msgobj   *pPrevious;
 	struct msgobj   *pNext;
 } msg;
 
-// Mailbox structure
+// Lightweight task, resumed as a function on the stack of the lite runner.
+// Embed it first in a struct holding the state the task keeps between runs.
+// A body must not make blocking kernel calls, it would block the runner.
+typedef struct liteobj {
+	int             (*pBody)(struct liteobj *pLite);
+	uint            DeadLine;
+	unsigned short  nLine;          // Continuation point, 0 at the start
+	struct mbox     *pWaitBox;      // Mailbox the task waits on
+	struct liteobj  *pNext;         // Next ready or waiting lite task
+} lite;
+
+// Results of a lite task body
+#define LT_YIELDED      0
+#define LT_WAITING      1
+#define LT_ENDED        2
+#define LT_POLLING      3       // Condition false, tried again at the next tick
+
+// Protothread style continuations, a body is LT_BEGIN ... LT_END and
+// local variables do not survive LT_YIELD, LT_WAIT_UNTIL or LT_RECEIVE
+#define LT_BEGIN(pLite)         switch((pLite)->nLine){ case 0:
+#define LT_END(pLite)           } (pLite)->nLine = 0; return LT_ENDED
+#define LT_YIELD(pLite)         do{ (pLite)->nLine = __LINE__; return LT_YIELDED; \
+                                    case __LINE__:; }while(0)
+#define LT_WAIT_UNTIL(pLite, c) do{ (pLite)->nLine = __LINE__; case __LINE__: \
+                                    if(!(c)) return LT_POLLING; }while(0)
+#define LT_RECEIVE(pLite, mBox, pData) \
+                                do{ (pLite)->nLine = __LINE__; case __LINE__: \
+                                    if(receive_no_wait((mBox), (pData)) != OK){ \
+                                      (pLite)->pWaitBox = (mBox); return LT_WAITING; } }while(0)
+
+// Message latency of a Mailbox in timer0_stamp() counts, see set_mailbox_stats()
+#define MSG_HIST_BUCKETS 24     // bucket i holds latencies in [2^i, 2^(i+1)) counts
 typedef struct {
+	uint            nCount;
+	uint            nMaxQueue;
+	uint            nMaxEndToEnd;
+	uint            Queue[MSG_HIST_BUCKETS];        // send to receive in this Mailbox
+	uint            EndToEnd[MSG_HIST_BUCKETS];     // start of the chain to receive here
+} msgstat;
+
+// Mailbox structure
+typedef struct mbox {
 	msg             *pHead;
 	msg             *pTail;
 	int             nDataSize;
 	int             nMaxMessages;
 	int             nMessages;
 	int             nBlockedMsg;
+	lite            *pLite;         // Lite tasks waiting for a Message
+	msgstat         *pStats;        // Latency statistics or NULL
+	uint            nFull;          // What a send to a full Mailbox does
+	msg             *pRoom;         // Senders waiting for room, by deadline
 } mailbox;
 
+// Modes of set_mailbox_full()
+#define MBOX_FULL_OVERWRITE     0       // send_no_wait overwrites the oldest, send_wait fails
+#define MBOX_FULL_BLOCK         1       // senders wait for room
+
+
+// Publish/subscribe topic and subscription, see Topic.h
+typedef struct topicobj topic;
+typedef struct subobj   subscriber;
+
+#define TOPIC_LATEST    1       // Subscriber queue keeping the latest value only
+
+// Byte stream, see Stream.h
+typedef struct streamobj stream;
+
+// Kernel instance, see KernelCtx.h
+typedef struct kernel_ctx kernel_ctx;
+
+// Time-triggered schedule, see Cyclic.h. The major frame of nMajor ticks
+// repeats and is split in minor frames of nMinor ticks.
+typedef struct {
+	uint            nOffset;        // Tick in the major frame the slot starts at
+	void            (*pBody)(void); // Runs to completion, NULL leaves the slot to Idle
+} cyclic_slot;
+
+typedef struct {
+	uint            nMajor;
+	uint            nMinor;
+	uint            nSlots;
+	const cyclic_slot *pSlot;       // Offsets increasing and below nMajor
+} cyclic_table;
+
 
 // Generic list item
 typedef struct l_obj {
 	TCB            *pTask;
 	uint           nTCnt;
+	utime          nWake;
 	msg            *pMessage;
+	exception      Status;          // Why a blocked task was made ready
+	struct l_obj   *pTimeout;       // Timerlist entry of a timed wait
+	struct l_obj   *pOwner;         // Task of a Timerlist timeout entry
 	struct l_obj   *pPrevious;
 	struct l_obj   *pNext;
 } listobj;
 
 
+// Software timer, see start_timer(). Owned by the caller, it is kept in
+// the Timerlist and its function is run by the timer service task.
+typedef struct swtimerobj {
+	listobj         Entry;          // Timerlist entry, pTask and pOwner are NULL
+	void            (*pFunc)(void *pArg);
+	void            *pArg;
+	uint            nTicks;         // First interval, used again by reset_timer
+	uint            nPeriod;        // Reload interval, 0 for a one-shot timer
+	uint            nQueued;        // State in the queue of the timer service task
+	struct swtimerobj *pNextExpired; // Next timer in that queue
+} swtimer;
+
+
 // Generic list
 typedef struct {
 	listobj        *pHead;
 	listobj        *pTail;
 } list;
 
+// Time partition with its own Readylist, see Partition.h. Owned by the
+// caller, it must stay valid while the kernel runs.
+typedef struct partobj {
+	list            *pReady;
+	uint            nBudget;        // Ticks per partition frame
+	uint            nLeft;          // Ticks left in this frame
+	uint            nFlags;
+	struct partobj  *pNext;
+} partition;
+
+#define PART_DONATE     1       // Budget left while it has nothing ready goes to others
+
 
 // Function prototypes
 
 
 // Task administration
 int             init_kernel(void);
+kernel_ctx*     create_kernel(void);
+void            select_kernel(kernel_ctx* pCtx);
 exception	create_task(void(*body)(), uint d);
 void            terminate(void);
 void            run(void);
@@ -119,27 +310,97 @@ void            run(void);
 mailbox*	create_mailbox(uint nMessages, uint nDataSize);
 int             no_messages(mailbox* mBox);
 exception       remove_mailbox(mailbox* mBox);
+void            set_mailbox_stats(mailbox* mBox, msgstat* pStats);
+void            set_mailbox_full(mailbox* mBox, uint nMode);
+uint            msg_age(void);
 
 exception       send_wait(mailbox* mBox, void* pData);
 exception       receive_wait(mailbox* mBox, void* pData);
+exception       send_wait_timeout(mailbox* mBox, void* pData, uint nMicros);
+exception       receive_wait_timeout(mailbox* mBox, void* pData, uint nMicros);
 
 exception	send_no_wait(mailbox* mBox, void* pData);
 int             receive_no_wait(mailbox* mBox, void* pData);
 
+exception       send_wait_len(mailbox* mBox, void* pData, uint nSize);
+exception       receive_wait_len(mailbox* mBox, void* pData, uint *pSize);
+exception       send_no_wait_len(mailbox* mBox, void* pData, uint nSize);
+int             receive_no_wait_len(mailbox* mBox, void* pData, uint *pSize);
+exception       call(mailbox* mBox, void* pRequest, void* pReply);
+exception       reply(void* pReply);
+
+// Lite tasks
+exception       create_lite(lite* pLite, int (*body)(lite* pLite), uint d);
+exception       lite_set_deadline(lite* pLite, uint nDeadline);
+
+// Publish/subscribe
+topic*          create_topic(uint nDataSize);
+exception       remove_topic(topic* pTopic);
+subscriber*     subscribe(topic* pTopic, uint nQueue);
+exception       unsubscribe(subscriber* pSub);
+exception       publish(topic* pTopic, void* pData);
+exception       take_wait(subscriber* pSub, void** ppData);
+int             take_no_wait(subscriber* pSub, void** ppData);
+void            release_payload(void* pData);
+
+// Byte streams
+stream*         create_stream(uint nSize, uint nTrigger);
+exception       remove_stream(stream* pStream);
+uint            stream_bytes(stream* pStream);
+exception       stream_send_wait(stream* pStream, void* pData, uint nBytes);
+uint            stream_send_no_wait(stream* pStream, void* pData, uint nBytes);
+exception       stream_receive_wait(stream* pStream, void* pData, uint nMax, uint* pGot);
+uint            stream_receive_no_wait(stream* pStream, void* pData, uint nMax);
+
 
 // Timing
 exception	wait(uint nTicks);
+exception       wait_us(uint nMicros);
+exception       wait_until(utime nMicros);
 void            set_ticks(uint no_of_ticks);
 uint            ticks(void);
+utime           now_us(void);
 uint		deadline(void);
+utime           deadline_tick_us(void);
 void            set_deadline(uint nNew);
-
-//Interrupt
+void            set_deadline_tick_us(utime nMicros);
+void            set_time_slice(uint nTicks);
+exception       init_timer(swtimer* pTimer, void (*pFunc)(void *pArg), void *pArg);
+exception       start_timer(swtimer* pTimer, uint nTicks, uint nPeriod);
+exception       reset_timer(swtimer* pTimer);
+void            stop_timer(swtimer* pTimer);
+
+// Memory
+void            kmem_flush(void);
+
+// Overload
+exception       set_miss_policy(uint nPolicy, uint nPeriod, void (*pMiss)(void *pTask));
+uint            miss_count(uint nPolicy);
+
+// CPU load
+uint            cpu_top(taskload* pLoad, uint nMax, uint* pIdle);
+
+// Cyclic executive
+exception       set_cyclic(const cyclic_table* pTable);
+uint            cyclic_overruns(uint* pSkipped);
+
+// Time partitions
+exception       create_partition(partition* pPart, uint nBudget, uint nFlags);
+exception       use_partition(partition* pPart);
+exception       set_partition_frame(uint nTicks);
+
+//Interrupt, post_work may also be called by tasks
+exception       post_work(void (*pFunc)(void *pArg), void *pArg);
 extern void     isr_off(void);
 extern void     isr_on(void);
 extern void     SaveContext(void);	// Stores DSP registers in TCB pointed to by Running
 extern void     LoadContext(void);	// Restores DSP registers from TCB pointed to by Running
+
 extern int mymem_count_alloc;  /**< define mymem_count_alloc Variable to see allocated memory . */ 
 extern int mymem_count_free;   /**< define mymem_count_free Variable to see free memory . */ 
+
+#ifdef __cplusplus
+}
+#endif
 #endif
 #pragma once
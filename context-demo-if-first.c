@@ -4,6 +4,7 @@
 TCB taskA;
 TCB taskB;
 TCB * Running;
+TCB ** pKernel = &Running;	// context.s79 reads Running through pKernel
 
 void task1(void);
 void task2(void);
@@ -3,6 +3,7 @@
 
 TCB taskA;
 TCB * Running;
+TCB ** pKernel = &Running;	// context.s79 reads Running through pKernel
 
 void task1(void);
 
@@ -0,0 +1,175 @@
+/**
+ * @file kernel.hpp
+ * @author Hussam Alshammari
+ * @date 19 oct 2026
+ * @brief Typed C++ front-end of the kernel, header only.
+ *
+ * Mailbox<T, N> carries Messages of one type T, so a wrong Message type
+ * is a compile error instead of a wrong nDataSize. How a Message
+ * passes the kernel is chosen at compile time:
+ *  - trivially copyable T is copied by the kernel with memcpy of
+ *    sizeof(T), as a C Mailbox of that size,
+ *  - other types are moved into a slot of the Mailbox and only the
+ *    slot number passes the kernel.
+ * The front-end adds type safety, not speed, a typed Mailbox costs
+ * the same as the generic one, see mailbox-bench.cpp.
+ *
+ * Task<Body, Deadline> creates a task whose deadline is checked at
+ * compile time.
+ */
+
+#ifndef KERNEL_HPP
+#define KERNEL_HPP
+
+#include <new>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "kernel.h"
+#include "kernel_hwdep.h"
+#include "OSFunctions/IsrStats.h"
+#ifdef KERNEL_STATIC
+#include "OSFunctions/KernelMem.h"
+#endif
+
+namespace art {
+
+/** \brief  task created with a deadline known at compile time
+
+    \param [in]    Body: the C function holding the code of the task.
+    \param [in]    Deadline: the deadline in ticks, must not be zero.
+ */
+template <void (*Body)(), uint Deadline>
+class Task {
+  static_assert(Deadline != 0, "a task needs a deadline");
+public:
+  static exception create() { return create_task(Body, Deadline); }
+};
+
+/** \brief  Mailbox holding up to N Messages of type T
+
+    Declare it with static storage, the kernel Mailbox is created by the
+    constructor and removed by the destructor. send/receive block as
+    send_wait/receive_wait, with nMicros as the timed variants.
+    post/poll do not block as send_no_wait/receive_no_wait.
+ */
+template <typename T, uint N, bool Trivial = std::is_trivially_copyable<T>::value>
+class Mailbox;
+
+// Part common to both kinds of Mailbox
+template <uint N, typename Token>
+class MailboxBase {
+  static_assert(N != 0, "a Mailbox needs room for one Message");
+public:
+  MailboxBase() : mBox(create_mailbox(N, sizeof(Token))) {}
+  ~MailboxBase() {
+    if (mBox != NULL) {
+      remove_mailbox(mBox);
+    }
+  }
+  bool valid() const { return mBox != NULL; }
+  int count() const { return no_messages(mBox); }
+  mailbox *handle() const { return mBox; }
+protected:
+  mailbox *mBox;
+private:
+  MailboxBase(const MailboxBase &);
+  MailboxBase &operator=(const MailboxBase &);
+};
+
+// Trivially copyable Messages, the kernel copies T
+template <typename T, uint N>
+class Mailbox<T, N, true> : public MailboxBase<N, T> {
+#ifdef KERNEL_STATIC
+  static_assert(sizeof(T) <= CFG_MSG_DATA_SIZE, "Message larger than CFG_MSG_DATA_SIZE");
+#endif
+  using MailboxBase<N, T>::mBox;
+public:
+  exception send(const T &data, uint nMicros = 0) {
+    return send_wait_timeout(mBox, const_cast<T *>(&data), nMicros);
+  }
+  exception receive(T &data, uint nMicros = 0) {
+    return receive_wait_timeout(mBox, &data, nMicros);
+  }
+  exception post(const T &data) {
+    return send_no_wait(mBox, const_cast<T *>(&data));
+  }
+  exception poll(T &data) {
+    return receive_no_wait(mBox, &data);
+  }
+};
+
+// Other Messages are moved through N slots, the kernel copies the slot number.
+// post fails instead of overwriting the oldest Message when all slots are used.
+template <typename T, uint N>
+class Mailbox<T, N, false> : public MailboxBase<N, uint> {
+  static_assert(std::is_move_constructible<T>::value && std::is_move_assignable<T>::value,
+                "Message type must be movable");
+  using MailboxBase<N, uint>::mBox;
+public:
+  Mailbox() : nFree(N) {
+    for (uint i = 0; i < N; i++) {
+      aFree[i] = i;
+    }
+  }
+  exception send(const T &data, uint nMicros = 0) { return put(data, nMicros, true); }
+  exception send(T &&data, uint nMicros = 0) { return put(std::move(data), nMicros, true); }
+  exception post(const T &data) { return put(data, 0, false); }
+  exception post(T &&data) { return put(std::move(data), 0, false); }
+  exception receive(T &data, uint nMicros = 0) {
+    uint nSlot;
+    exception status = receive_wait_timeout(mBox, &nSlot, nMicros);
+    if (status == OK) {
+      get(data, nSlot);
+    }
+    return status;
+  }
+  exception poll(T &data) {
+    uint nSlot;
+    exception status = receive_no_wait(mBox, &nSlot);
+    if (status == OK) {
+      get(data, nSlot);
+    }
+    return status;
+  }
+private:
+  T *slot(uint nSlot) { return reinterpret_cast<T *>(&aSlot[nSlot]); }
+  template <typename U>
+  exception put(U &&data, uint nMicros, bool bWait) {
+    int x = set_isr(ISR_OFF);
+    ISR_ENTER(ISR_SITE_MAILBOX);
+    uint nSlot = nFree > 0 ? aFree[--nFree] : N;
+    ISR_EXIT();
+    set_isr(x);
+    if (nSlot == N) {
+      return FAIL;
+    }
+    new (slot(nSlot)) T(std::forward<U>(data));
+    exception status = bWait ? send_wait_timeout(mBox, &nSlot, nMicros)
+                             : send_no_wait(mBox, &nSlot);
+    if (status != OK) {
+      release(nSlot);
+    }
+    return status;
+  }
+  void get(T &data, uint nSlot) {
+    data = std::move(*slot(nSlot));
+    release(nSlot);
+  }
+  void release(uint nSlot) {
+    slot(nSlot)->~T();
+    int x = set_isr(ISR_OFF);
+    ISR_ENTER(ISR_SITE_MAILBOX);
+    aFree[nFree++] = nSlot;
+    ISR_EXIT();
+    set_isr(x);
+  }
+
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type aSlot[N];
+  uint aFree[N];
+  uint nFree;
+};
+
+} // namespace art
+
+#endif
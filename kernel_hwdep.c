@@ -1,6 +1,12 @@
 /* 2002-11-19 Wolfgang Svensson*/
 #include <stdlib.h>
+#ifdef KERNEL_HOST
+#include <time.h>
+#endif
 #include "kernel_hwdep.h"
+#ifndef KERNEL_HOST
+#include "OSFunctions/TimerFunctions.h"
+#endif
 
 /*-------------------------------------------------------------------------*/
 /* uint set_isr( uint newCSR )  - Change interrupt ON/OFF                  */
@@ -38,7 +44,7 @@ void timer0_start(void)
  Internal clock 50 MHz -> Timer 0 period 25 ns - ~20 ms.
 See Prescale timer 8-9*/ 
   rTPRE0 = 0x3f;
-  rTDAT0 = 0x1e01;
+  rTDAT0 = TIMER_TICK_COUNTS;
 
 /* "IRQ" - not "FIRQ" , Reset pp11-3*/
   rINTMOD = 0x00000000;	
@@ -48,3 +54,58 @@ Activate interrupt globally. Bit 6, GIE=1, pp15-6*/
   rINTMSK = 0x100; 
   rSYSCON |= 0x40;
 }
+
+/*-------------------------------------------------------------------------*/
+/* uint timer0_stamp( void )  - Free running time stamp                    */
+/*	Low 32 bits of now_counts(), the time base of the kernel, so the   */
+/*	varying timer periods are all counted. Only differences between	   */
+/*	stamps less than 2^32 counts apart are meaningful.		   */
+/*	On a host build (KERNEL_HOST) the monotonic clock in ns is used.   */
+/* HW dependent	  							   */
+/* Returns: time stamp in timer counts (ns on host)			   */
+/*-------------------------------------------------------------------------*/
+
+unsigned int timer0_stamp( void ) {
+#ifdef KERNEL_HOST
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned int)ts.tv_sec * 1000000000u + (unsigned int)ts.tv_nsec;
+#else
+	unsigned int x = set_isr(ISR_OFF);
+	unsigned int stamp = (unsigned int)now_counts();
+	set_isr(x);
+	return stamp;
+#endif
+}
+
+/*-------------------------------------------------------------------------*/
+/* uint timer0_count( void )  - Current Timer 0 count                      */
+/*	Counts up from 0 to the interval set in TDAT0, then restarts.      */
+/* HW dependent	  							   */
+/* Returns: count since the start of the current period		   */
+/*-------------------------------------------------------------------------*/
+
+unsigned int timer0_count( void ) {
+	return rTCNT0;
+}
+
+/*-------------------------------------------------------------------------*/
+/* uint timer0_pending( void )  - Timer 0 interrupt pending                */
+/*	TRUE when the period has ended but the interrupt is not served.    */
+/* HW dependent	  							   */
+/*-------------------------------------------------------------------------*/
+
+unsigned int timer0_pending( void ) {
+	return (rINTPND & 0x100) != 0;
+}
+
+/*-------------------------------------------------------------------------*/
+/* void timer0_set_interval( uint nCounts )  - Set Timer 0 period          */
+/*	The new match value is used by the running period.		   */
+/* HW dependent	  							   */
+/* Argument: period in timer counts, at most 0xffff			   */
+/*-------------------------------------------------------------------------*/
+
+void timer0_set_interval( unsigned int nCounts ) {
+	rTDAT0 = (unsigned short)nCounts;
+}
@@ -12,6 +12,11 @@
 #define rTDAT0 (*(volatile unsigned short*)(0x7ff9000))
 #define rTPRE0 (*(volatile unsigned char *)(0x7ff9002))/* Prescale timer 8-9, ~400 ms*/
 #define rTCON0 (*(volatile unsigned char *)(0x7ff9003))
+#define rTCNT0 (*(volatile unsigned short*)(0x7ff9006))/* Current count 8-4 */
+
+#define TIMER_TICK_COUNTS 0x1e01  /* Timer 0 counts per tick */
+#define TIMER_COUNT_NS    1280    /* MCLK 50 MHz / 64 -> 1.28 us per count */
+#define TIMER_MIN_COUNTS  8       /* Shortest period that can be programmed */
 
 /*------------ Interrupt Control-------------- */
 #define rSYSCON (*(volatile unsigned char *)(0x7ffd003))
@@ -19,9 +24,22 @@
 #define rINTPND (*(volatile unsigned*)(0x7ffc004))
 #define rINTMSK (*(volatile unsigned*)(0x7ffc008))
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 //void Init_IRQ_TINT0(void);
 unsigned int set_isr( unsigned int newCSR );
 extern unsigned int Get_psr(void);
 extern void Set_psr(unsigned int PSR);
+void timer0_start(void);
+unsigned int timer0_stamp(void);
+unsigned int timer0_count(void);
+unsigned int timer0_pending(void);
+void timer0_set_interval(unsigned int nCounts);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif
@@ -0,0 +1,86 @@
+/**************************************************************************//**
+ * @file     mailbox-bench.cpp
+ * @brief    ART Real Time Micro Kernel Mailbox copy benchmark
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Compares the generic Mailbox with the typed Mailbox<T, N> of
+ * kernel.hpp for 4, 16 and 256 byte Messages. Both are copied with
+ * memcpy by the kernel, the results show the cost of the front-end,
+ * which should be none. Each
+ * round is a send_no_wait followed by a receive_no_wait. Build it
+ * instead of main.c and read benchResult in the debugger, the values
+ * are timer 0 counts (1.28 us) per BENCH_ROUNDS rounds.
+ *
+ ******************************************************************************/
+
+#include "kernel.hpp"
+
+#define BENCH_ROUNDS    1000
+
+template <uint Size>
+struct Payload {
+  uint aWord[Size / sizeof(uint)];
+};
+
+enum { BENCH_GENERIC, BENCH_TYPED };
+
+uint benchResult[3][2];         /**< [4, 16, 256 bytes][generic, typed]. */
+volatile uint benchDone;        /**< Set when benchResult is complete. */
+
+template <uint Size>
+static void bench(uint aResult[2])
+{
+  Payload<Size> in, out;
+  for (uint i = 0; i < Size / sizeof(uint); i++) {
+    in.aWord[i] = i;
+  }
+
+  mailbox *mBox = create_mailbox(1, sizeof(in));
+  if (mBox != NULL) {
+    uint nStart = timer0_stamp();
+    for (uint i = 0; i < BENCH_ROUNDS; i++) {
+      send_no_wait(mBox, &in);
+      receive_no_wait(mBox, &out);
+    }
+    aResult[BENCH_GENERIC] = timer0_stamp() - nStart;
+    remove_mailbox(mBox);
+  }
+
+  static art::Mailbox<Payload<Size>, 1> typed;
+  if (typed.valid()) {
+    uint nStart = timer0_stamp();
+    for (uint i = 0; i < BENCH_ROUNDS; i++) {
+      typed.post(in);
+      typed.poll(out);
+    }
+    aResult[BENCH_TYPED] = timer0_stamp() - nStart;
+  }
+}
+
+static void bench_task()
+{
+  bench<4>(benchResult[0]);
+  bench<16>(benchResult[1]);
+  bench<256>(benchResult[2]);
+  benchDone = TRUE;
+  terminate();
+}
+
+int main(void)
+{
+  if (init_kernel() != OK) {
+    /* Memory allocation problems */
+    while(1);
+  }
+  if (art::Task<bench_task, 10000>::create() != OK) {
+    /* Memory allocation problems */
+    while(1);
+  }
+  run();
+  return 1;
+}
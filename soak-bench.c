@@ -0,0 +1,386 @@
+/**************************************************************************//**
+ * @file     soak-bench.c
+ * @brief    ART Real Time Micro Kernel soak benchmark
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Drives random kernel traffic for SOAK_HOURS. Worker tasks with random
+ * deadlines are created and terminate all the time. They use a few
+ * shared Mailboxes with send_wait, receive_wait, send_no_wait,
+ * receive_no_wait and wait. Every SOAK_WINDOW_US the control task stops
+ * creating workers. It waits until all have terminated and empties the
+ * Mailboxes, then writes a report to soakReport:
+ *  - operations per second,
+ *  - p99 latency of each kind of call, blocking time included,
+ *  - the longest Readylist, Waitinglist and Timerlist seen,
+ *  - mymem_count_alloc - mymem_count_free with nothing alive.
+ *
+ * The first window is the reference. The run fails (soakFailed) when
+ * the memory balance differs from it, or when a p99 latency or the
+ * throughput drifts more than SOAK_DRIFT_PCT percent from it. The
+ * latencies are kept in log-linear histograms, SOAK_LAT_SUB buckets per
+ * power of two, so a latency of any length is resolved to 1/SOAK_LAT_SUB.
+ * All SOAK_ settings can be given on the command line. Build it
+ * instead of main.c and read the results in the debugger.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "kernel.h"
+#include "kernel_hwdep.h"
+#include "OSFunctions/KernelCtx.h"
+
+#ifndef SOAK_HOURS
+#define SOAK_HOURS      4
+#endif
+#ifndef SOAK_WINDOW_US
+#define SOAK_WINDOW_US  10000000        /**< report period. */
+#endif
+#ifndef SOAK_REPORTS
+#define SOAK_REPORTS    16              /**< last reports kept. */
+#endif
+#ifndef SOAK_WORKERS
+#define SOAK_WORKERS    4               /**< workers alive at once. */
+#endif
+#ifndef SOAK_BOXES
+#define SOAK_BOXES      2
+#endif
+#ifndef SOAK_OPS
+#define SOAK_OPS        32              /**< kernel calls of one worker. */
+#endif
+#ifndef SOAK_DEADLINE
+#define SOAK_DEADLINE   20              /**< longest worker deadline in ticks. */
+#endif
+#ifndef SOAK_CONTROL
+#define SOAK_CONTROL    50              /**< deadline of the control task in ticks. */
+#endif
+#ifndef SOAK_LAT_SUB
+#define SOAK_LAT_SUB    8               /**< histogram buckets per power of two, a power of two. */
+#endif
+#ifndef SOAK_DRIFT_PCT
+#define SOAK_DRIFT_PCT  25              /**< allowed drift from the first window in percent. */
+#endif
+
+#define SOAK_WINDOWS    (SOAK_HOURS * 3600 / (SOAK_WINDOW_US / 1000000))
+#define SOAK_LAT_BUCKETS (SOAK_LAT_SUB * 33)    /**< enough for any 32 bit latency. */
+
+// Kinds of kernel calls, each has its own latency histogram
+enum {
+  SOAK_SEND_WAIT,
+  SOAK_RECEIVE_WAIT,
+  SOAK_SEND_NO_WAIT,
+  SOAK_RECEIVE_NO_WAIT,
+  SOAK_WAIT,
+  SOAK_CALLS
+};
+
+// Why the run failed
+enum {
+  SOAK_OK,
+  SOAK_FAIL_MEMORY,
+  SOAK_FAIL_LATENCY,
+  SOAK_FAIL_THROUGHPUT,
+  SOAK_FAIL_SETUP
+};
+
+// One report window
+typedef struct {
+  uint          nWindow;
+  uint          nOpsPerSec;
+  uint          nCalls[SOAK_CALLS];
+  uint          nP99[SOAK_CALLS]; // timer0_stamp() counts (1.28 us)
+  uint          nReady;
+  uint          nWaiting;
+  uint          nTimer;
+  int           nMemBalance;
+  uint          nWorkers;       // workers created in the window
+} soak_report;
+
+extern int mymem_count_alloc;
+extern int mymem_count_free;
+
+soak_report soakReport[SOAK_REPORTS];   /**< ring of the last reports. */
+soak_report soakFirst;                  /**< the reference window. */
+uint soakWindows;                       /**< reports made. */
+volatile uint soakFailed;               /**< SOAK_OK or why the run failed. */
+volatile uint soakDone;                 /**< Set when the run is over. */
+
+static mailbox *soakBox[SOAK_BOXES];
+static uint soakSeed = 0x2545F491;
+static uint soakLive;                   // workers alive
+static uint soakOps;                    // kernel calls in the window
+static uint soakLat[SOAK_CALLS][SOAK_LAT_BUCKETS];
+
+/** \brief  next pseudo random number, xorshift32
+
+    \param [in]      none
+    \return          the number
+ */
+static uint soak_rand(void){
+  int x = set_isr(ISR_OFF);
+  uint n = soakSeed;
+  n ^= n << 13;
+  n ^= n >> 17;
+  n ^= n << 5;
+  soakSeed = n;
+  set_isr(x);
+  return n;
+}
+
+/** \brief  number of items in a kernel list
+
+    \param [in]      pList: the list
+    \return          the number of items
+ */
+static uint soak_length(list *pList){
+  int x = set_isr(ISR_OFF);
+  uint n = 0;
+  listobj *pObj;
+  for(pObj = pList->pHead->pNext; pObj != pList->pTail; pObj = pObj->pNext){
+    n++;
+  }
+  set_isr(x);
+  return n;
+}
+
+/** \brief  histogram bucket of a latency
+
+    Below 2*SOAK_LAT_SUB every count has its own bucket, above that
+    each power of two is split in SOAK_LAT_SUB buckets.
+
+    \param [in]      nTime: the latency in timer counts
+    \return          the bucket
+ */
+static uint soak_bucket(uint nTime){
+  uint nShift = 0;
+  while((nTime >> nShift) >= 2*SOAK_LAT_SUB){
+    nShift++;
+  }
+  return nShift*SOAK_LAT_SUB + (nTime >> nShift);
+}
+
+/** \brief  smallest latency of a histogram bucket
+
+    \param [in]      nBucket: the bucket
+    \return          the latency in timer counts
+ */
+static uint soak_bucket_time(uint nBucket){
+  uint nShift;
+  if(nBucket < 2*SOAK_LAT_SUB){
+    return nBucket;
+  }
+  nShift = nBucket/SOAK_LAT_SUB - 1;
+  return (nBucket - nShift*SOAK_LAT_SUB) << nShift;
+}
+
+/** \brief  worker task
+
+    Makes SOAK_OPS random kernel calls and terminates, the latency of
+    every call goes to the histogram of its kind. A blocking call that
+    returns DEADLINE_REACHED ends the worker early.
+
+    \param [in]      none
+    \return          none
+ */
+static void soak_worker(void){
+  uint nOps = 0;
+  uint nData;
+  exception status = OK;
+  int x;
+  while(nOps < SOAK_OPS && status != DEADLINE_REACHED){
+    uint nRand = soak_rand();
+    uint nCall = nRand % SOAK_CALLS;
+    mailbox *mBox = soakBox[(nRand >> 8) % SOAK_BOXES];
+    uint nStart = timer0_stamp();
+    uint nTime;
+    nData = nRand;
+    switch(nCall){
+    case SOAK_SEND_WAIT:
+      status = send_wait(mBox, &nData);
+      break;
+    case SOAK_RECEIVE_WAIT:
+      status = receive_wait(mBox, &nData);
+      break;
+    case SOAK_SEND_NO_WAIT:
+      send_no_wait(mBox, &nData);
+      status = OK;
+      break;
+    case SOAK_RECEIVE_NO_WAIT:
+      receive_no_wait(mBox, &nData);
+      status = OK;
+      break;
+    default:
+      status = wait(1 + (nRand >> 16) % 3);
+      break;
+    }
+    nTime = timer0_stamp() - nStart;
+    x = set_isr(ISR_OFF);
+    soakLat[nCall][soak_bucket(nTime)]++;
+    set_isr(x);
+    nOps++;
+  }
+  x = set_isr(ISR_OFF);
+  soakOps += nOps;
+  soakLive--;
+  set_isr(x);
+  terminate();
+}
+
+/** \brief  99th percentile of a latency histogram
+
+    \param [in]      pLat: the histogram of one kind of call
+    \param [out]     pCalls: the number of calls in it
+    \return          the latency in timer counts, 0 without calls
+ */
+static uint soak_p99(const uint *pLat, uint *pCalls){
+  uint nTotal = 0;
+  uint nSum = 0;
+  uint i;
+  for(i = 0; i < SOAK_LAT_BUCKETS; i++){
+    nTotal += pLat[i];
+  }
+  *pCalls = nTotal;
+  if(nTotal == 0){
+    return 0;
+  }
+  for(i = 0; i < SOAK_LAT_BUCKETS - 1; i++){
+    nSum += pLat[i];
+    if((utime)nSum * 100 >= (utime)nTotal * 99){
+      break;
+    }
+  }
+  return soak_bucket_time(i);
+}
+
+/** \brief  check a window against the first one
+
+    A p99 latency may grow and the throughput may drop by
+    SOAK_DRIFT_PCT percent, a latency also by one timer count.
+
+    \param [in]      pReport: the window
+    \return          SOAK_OK or why it failed
+ */
+static uint soak_drift(const soak_report *pReport){
+  uint i;
+  for(i = 0; i < SOAK_CALLS; i++){
+    if(pReport->nCalls[i] > 0 && soakFirst.nCalls[i] > 0 &&
+       (utime)pReport->nP99[i] * 100 > (utime)soakFirst.nP99[i] * (100 + SOAK_DRIFT_PCT) + 100){
+      return SOAK_FAIL_LATENCY;
+    }
+  }
+  if((utime)pReport->nOpsPerSec * 100 < (utime)soakFirst.nOpsPerSec * (100 - SOAK_DRIFT_PCT)){
+    return SOAK_FAIL_THROUGHPUT;
+  }
+  return SOAK_OK;
+}
+
+/** \brief  close a window and check it against the first one
+
+    Waits until no worker is alive and the Mailboxes are empty, so the
+    memory balance does not depend on the traffic of the moment.
+
+    \param [in]      pReport: the window, list lengths already set
+    \param [in]      nStart: now_us() when the window started
+    \return          none
+ */
+static void soak_close(soak_report *pReport, utime nStart){
+  uint nData;
+  uint i;
+  utime nTime;
+  while(soakLive > 0){
+    set_deadline(ticks() + SOAK_CONTROL);
+    wait(1);
+  }
+  for(i = 0; i < SOAK_BOXES; i++){
+    while(receive_no_wait(soakBox[i], &nData) == OK){
+    }
+  }
+  nTime = now_us() - nStart;
+  pReport->nWindow = soakWindows;
+  pReport->nOpsPerSec = (uint)((utime)soakOps * 1000000 / (nTime ? nTime : 1));
+  for(i = 0; i < SOAK_CALLS; i++){
+    pReport->nP99[i] = soak_p99(soakLat[i], &pReport->nCalls[i]);
+  }
+  pReport->nMemBalance = mymem_count_alloc - mymem_count_free;
+  soakReport[soakWindows % SOAK_REPORTS] = *pReport;
+  if(soakWindows == 0){
+    soakFirst = *pReport;
+  }
+  else if(pReport->nMemBalance != soakFirst.nMemBalance){
+    soakFailed = SOAK_FAIL_MEMORY;
+  }
+  else{
+    soakFailed = soak_drift(pReport);
+  }
+  soakWindows++;
+  soakOps = 0;
+  memset(soakLat, 0, sizeof(soakLat));
+}
+
+/** \brief  control task
+
+    Keeps SOAK_WORKERS workers alive and closes a window every
+    SOAK_WINDOW_US until SOAK_WINDOWS are done or the run fails.
+
+    \param [in]      none
+    \return          none
+ */
+static void soak_control(void){
+  soak_report report = { 0 };
+  utime nStart = now_us();
+  while(soakWindows < SOAK_WINDOWS && soakFailed == SOAK_OK){
+    uint n;
+    set_deadline(ticks() + SOAK_CONTROL);
+    while(soakLive < SOAK_WORKERS){
+      int x = set_isr(ISR_OFF);
+      soakLive++;
+      set_isr(x);
+      if(create_task(soak_worker, ticks() + 1 + soak_rand() % SOAK_DEADLINE) != OK){
+        x = set_isr(ISR_OFF);
+        soakLive--;
+        set_isr(x);
+        break;
+      }
+      report.nWorkers++;
+    }
+    n = soak_length(readyL);
+    report.nReady = n > report.nReady ? n : report.nReady;
+    n = soak_length(waitingL);
+    report.nWaiting = n > report.nWaiting ? n : report.nWaiting;
+    n = soak_length(timmerL);
+    report.nTimer = n > report.nTimer ? n : report.nTimer;
+    wait(1);
+    if(now_us() - nStart >= SOAK_WINDOW_US){
+      soak_close(&report, nStart);
+      report = (soak_report){ 0 };
+      nStart = now_us();
+    }
+  }
+  soakDone = TRUE;
+  terminate();
+}
+
+int main(void)
+{
+  uint i;
+  if (init_kernel() != OK) {
+    /* Memory allocation problems */
+    while(1);
+  }
+  for (i = 0; i < SOAK_BOXES; i++) {
+    if ((soakBox[i] = create_mailbox(4, sizeof(uint))) == NULL) {
+      soakFailed = SOAK_FAIL_SETUP;
+      while(1);
+    }
+  }
+  if (create_task(soak_control, SOAK_CONTROL) != OK) {
+    soakFailed = SOAK_FAIL_SETUP;
+    while(1);
+  }
+  run();
+  return 1;
+}
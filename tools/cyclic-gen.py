@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""ART Real Time Micro Kernel cyclic schedule generator
+
+Builds the cyclic_table of set_cyclic (OSFunctions/Cyclic.h) from the
+periods and WCETs of a task set and writes it as C. It runs on the host
+and is not part of the kernel build:
+
+    tools/cyclic-gen.py [-m minor] tasks.txt > cyclic_table.c
+
+A task file holds one periodic task per line, times are in ticks:
+
+    task <body> <wcet> <period> [deadline]
+
+body is the C function run to completion in each slot of the task,
+deadline defaults to the period. Lines starting with # are comments.
+
+The major frame is the hyperperiod. Unless given with -m, the minor
+frame is the largest divisor of it that holds the longest wcet and
+keeps 2f - gcd(f, period) <= deadline for every task, so each job has a
+whole frame between its release and its deadline. The jobs of the major
+frame are put in frames in deadline order, one after the other from
+the start of the frame, each job in a slot at the tick it starts. A job
+is not split over frames. When the jobs do not fit the next smaller
+minor frame is tried.
+
+The ticks of a frame after its last slot are left to Idle.
+"""
+
+import argparse
+import math
+import sys
+from functools import reduce
+
+MAJOR_LIMIT = 1 << 16   # longest major frame in ticks
+
+
+class Task:
+    def __init__(self, body, C, T, D):
+        self.body, self.C, self.T, self.D = body, C, T, D
+
+
+def read_tasks(path):
+    aTask = []
+    with open(path) as f:
+        for nLine, line in enumerate(f, 1):
+            part = line.split()
+            if not part or part[0].startswith("#"):
+                continue
+            try:
+                if part[0] != "task" or len(part) not in (4, 5):
+                    raise ValueError
+                C, T = int(part[2]), int(part[3])
+                D = int(part[4]) if len(part) == 5 else T
+                if C <= 0 or T <= 0 or D < C or D > T:
+                    raise ValueError
+            except ValueError:
+                sys.exit("%s:%d: expected task <body> <wcet> <period> [deadline]" % (path, nLine))
+            aTask.append(Task(part[1], C, T, D))
+    if not aTask:
+        sys.exit("%s: no tasks" % path)
+    return aTask
+
+
+def minor_frames(aTask, nMajor):
+    """Candidate minor frames, largest first."""
+    nWcet = max(t.C for t in aTask)
+    for f in range(nMajor, 0, -1):
+        if nMajor % f == 0 and f >= nWcet and \
+           all(2 * f - math.gcd(f, t.T) <= t.D for t in aTask):
+            yield f
+
+
+def pack(aTask, nMajor, nMinor):
+    """Slots (offset, task) of the major frame or None."""
+    aJob = []   # (deadline, release, task)
+    for t in aTask:
+        for r in range(0, nMajor, t.T):
+            aJob.append((r + t.D, r, t))
+    aJob.sort(key=lambda j: (j[0], j[1]))
+    aSlot = []
+    aDone = [False] * len(aJob)
+    for nStart in range(0, nMajor, nMinor):
+        nAt = nStart
+        for i, (d, r, t) in enumerate(aJob):
+            if aDone[i] or r > nStart:
+                continue
+            if nAt + t.C <= nStart + nMinor and nAt + t.C <= d:
+                aSlot.append((nAt, t))
+                aDone[i] = True
+                nAt += t.C
+        for i, (d, r, t) in enumerate(aJob):
+            if not aDone[i] and d <= nStart + nMinor:
+                return None     # missed in this frame
+    return aSlot if all(aDone) else None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="cyclic_table of a periodic task set")
+    parser.add_argument("-m", type=int, help="minor frame in ticks")
+    parser.add_argument("-n", default="cyclicTable", help="name of the table")
+    parser.add_argument("tasks")
+    args = parser.parse_args()
+
+    aTask = read_tasks(args.tasks)
+    nMajor = reduce(lambda a, b: a * b // math.gcd(a, b), (t.T for t in aTask))
+    if nMajor > MAJOR_LIMIT:
+        sys.exit("major frame of %d ticks, above %d" % (nMajor, MAJOR_LIMIT))
+    U = sum(t.C / t.T for t in aTask)
+    if U > 1:
+        sys.exit("overload U=%.4f" % U)
+
+    if args.m is not None:
+        aMinor = [args.m] if args.m > 0 and nMajor % args.m == 0 else []
+    else:
+        aMinor = minor_frames(aTask, nMajor)
+    for nMinor in aMinor:
+        aSlot = pack(aTask, nMajor, nMinor)
+        if aSlot is not None:
+            break
+    else:
+        sys.exit("no minor frame fits, U=%.4f major %d" % (U, nMajor))
+
+    print("/* Generated by tools/cyclic-gen.py from %s" % args.tasks)
+    print(" * major frame %d ticks, minor frame %d ticks, U=%.4f */" % (nMajor, nMinor, U))
+    print()
+    print('#include "kernel.h"')
+    print()
+    for body in sorted(set(t.body for t in aTask)):
+        print("void %s(void);" % body)
+    print()
+    print("static const cyclic_slot %sSlots[] = {" % args.n)
+    for nAt, t in aSlot:
+        print("  { %5d, %s }," % (nAt, t.body))
+    print("};")
+    print()
+    print("const cyclic_table %s = { %d, %d, %d, %sSlots };" %
+          (args.n, nMajor, nMinor, len(aSlot), args.n))
+
+    for nStart in range(0, nMajor, nMinor):
+        nBusy = sum(t.C for nAt, t in aSlot if nStart <= nAt < nStart + nMinor)
+        sys.stderr.write("frame %5d: %d of %d ticks\n" % (nStart, nBusy, nMinor))
+
+
+if __name__ == "__main__":
+    main()
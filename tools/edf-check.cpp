@@ -0,0 +1,367 @@
+/**************************************************************************//**
+ * @file     edf-check.cpp
+ * @brief    ART Real Time Micro Kernel EDF schedulability analysis
+ * @version  V1
+ * @date     19. October 2026
+ *
+ * @note
+ * Copyright (C) 2016-2017 Hussam Alshammari. All rights reserved.
+ *
+ * @par
+ * Offline check of task sets before they become create_task calls.
+ * It runs on the host and is not part of the kernel build:
+ *
+ *     g++ -O3 -march=native -std=c++11 -pthread tools/edf-check.cpp -o edf-check
+ *     ./edf-check [-j threads] [-v] tasksets.txt
+ *
+ * A task set file holds sets of periodic tasks, times are in ticks:
+ *
+ *     set <name>
+ *     task <wcet> <period> <deadline> [blocking]
+ *
+ * blocking is the longest time a job waits in send_wait/receive_wait
+ * for its partner. It is added to the wcet, a suspension-oblivious
+ * bound. Lines starting with # are comments.
+ *
+ * The deadlines are those of the kernel. A job released at tick r gets
+ * DeadLine r + deadline and is missed when TimerInt finds TC equal to
+ * it. insertRL puts a job after the jobs with the same DeadLine, which
+ * the analysis covers by counting equal deadlines as interfering. For
+ * each set it runs:
+ *  - the exact processor demand test, dbf(t) <= t at every absolute
+ *    deadline t in the first busy period. dbf is evaluated for a block
+ *    of deadlines at a time in loops the compiler vectorizes.
+ *  - the EDF response time analysis of Spuri, giving the worst case
+ *    response time R of every task.
+ *
+ * Sets are spread over all cores. Each set gets one output line in file
+ * order: whether it fits, the utilization, the smallest demand slack
+ * t - dbf(t) with its t, and the task with the least deadline slack
+ * D - R. With -v all response times are listed.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define EDF_HORIZON     (1 << 24)       /**< longest busy period analysed, ticks. */
+#define EDF_BLOCK       256             /**< deadlines evaluated at a time. */
+
+// One periodic task, C includes the blocking time
+struct Task {
+  long          C;
+  long          T;
+  long          D;
+};
+
+// One task set and its result
+struct TaskSet {
+  std::string   Name;
+  int           nLine;
+  std::vector<Task> aTask;
+  // Result
+  bool          bFits;
+  bool          bUndecided;     // busy period longer than EDF_HORIZON
+  double        U;
+  long          nSlack;         // smallest t - dbf(t)
+  long          nSlackAt;
+  std::vector<long> aR;         // response times, empty when not analysed
+};
+
+/** \brief  length of the synchronous busy period
+
+    \param [in]      set: the tasks, with a utilization of at most 1
+    \return          the length or -1 beyond EDF_HORIZON
+ */
+static long busy_period(const TaskSet &set)
+{
+  long L = 0, W = 0;
+  for (const Task &t : set.aTask) {
+    W += t.C;
+  }
+  while (W != L) {
+    L = W;
+    if (L > EDF_HORIZON) {
+      return -1;
+    }
+    W = 0;
+    for (const Task &t : set.aTask) {
+      W += (L + t.T - 1) / t.T * t.C;
+    }
+  }
+  return L;
+}
+
+/** \brief  demand of all tasks at a block of deadlines
+
+    Lanes are independent and the quotient is exact in double below
+    EDF_HORIZON, so the inner loop is vectorized.
+
+    \param [in]      aC, aT, aD: the tasks as arrays of nTasks
+    \param [in]      aTime: nTimes absolute deadlines
+    \param [out]     aDemand: dbf at each of them
+    \return          none
+ */
+static void demand_block(const double *__restrict aC, const double *__restrict aT,
+                         const double *__restrict aD, int nTasks,
+                         const double *__restrict aTime, double *__restrict aDemand, int nTimes)
+{
+  for (int k = 0; k < nTimes; k++) {
+    aDemand[k] = 0;
+  }
+  for (int j = 0; j < nTasks; j++) {
+    const double C = aC[j], T = aT[j], D = aD[j];
+    for (int k = 0; k < nTimes; k++) {
+      double nJobs = std::floor((aTime[k] - D) / T) + 1;
+      aDemand[k] += C * (nJobs > 0 ? nJobs : 0);
+    }
+  }
+}
+
+/** \brief  processor demand test
+
+    Checks every absolute deadline up to the busy period L, the
+    deadlines of one task at a time in blocks of EDF_BLOCK.
+
+    \param [in,out]  set: the tasks, nSlack and nSlackAt are set
+    \param [in]      L: the busy period
+    \return          true if dbf(t) <= t everywhere
+ */
+static bool demand_test(TaskSet &set, long L)
+{
+  int n = (int)set.aTask.size();
+  std::vector<double> aC(n), aT(n), aD(n);
+  double aTime[EDF_BLOCK], aDemand[EDF_BLOCK];
+  for (int j = 0; j < n; j++) {
+    aC[j] = (double)set.aTask[j].C;
+    aT[j] = (double)set.aTask[j].T;
+    aD[j] = (double)set.aTask[j].D;
+  }
+  set.nSlack = L + 1;
+  set.nSlackAt = 0;
+  for (const Task &t : set.aTask) {
+    for (long d = t.D; d <= L; ) {
+      int nTimes = 0;
+      for (; nTimes < EDF_BLOCK && d <= L; d += t.T) {
+        aTime[nTimes++] = (double)d;
+      }
+      demand_block(aC.data(), aT.data(), aD.data(), n, aTime, aDemand, nTimes);
+      for (int k = 0; k < nTimes; k++) {
+        long nSlack = (long)aTime[k] - (long)aDemand[k];
+        if (nSlack < set.nSlack) {
+          set.nSlack = nSlack;
+          set.nSlackAt = (long)aTime[k];
+        }
+      }
+    }
+  }
+  return set.nSlack >= 0;
+}
+
+/** \brief  worst case response time of one task under EDF
+
+    Spuri's analysis: a job of task i released at offset a in the busy
+    period is delayed by every job with a deadline not after its own.
+
+    \param [in]      set: the tasks
+    \param [in]      i: the task
+    \param [in]      L: the busy period
+    \return          the response time in ticks
+ */
+static long response_time(const TaskSet &set, int i, long L)
+{
+  const Task &ti = set.aTask[i];
+  std::vector<long> aOffset;
+  for (const Task &tj : set.aTask) {
+    for (long a = tj.D - ti.D; a <= L - ti.C; a += tj.T) {
+      if (a >= 0) {
+        aOffset.push_back(a);
+      }
+    }
+  }
+  std::sort(aOffset.begin(), aOffset.end());
+  aOffset.erase(std::unique(aOffset.begin(), aOffset.end()), aOffset.end());
+
+  long R = ti.C;
+  for (long a : aOffset) {
+    long nOwn = (1 + a / ti.T) * ti.C;
+    long nLen = nOwn, nPrev = -1;
+    while (nLen != nPrev && nLen <= EDF_HORIZON) {
+      nPrev = nLen;
+      nLen = nOwn;
+      for (size_t j = 0; j < set.aTask.size(); j++) {
+        const Task &tj = set.aTask[j];
+        if ((int)j == i || tj.D > a + ti.D) {
+          continue;
+        }
+        long nCeil = (nPrev + tj.T - 1) / tj.T;
+        long nBefore = 1 + (a + ti.D - tj.D) / tj.T;
+        nLen += std::min(nCeil, nBefore) * tj.C;
+      }
+    }
+    R = std::max(R, nLen - a);
+  }
+  return R;
+}
+
+/** \brief  analyse one task set
+
+    \param [in,out]  set: the tasks, the result fields are set
+    \return          none
+ */
+static void analyse(TaskSet &set)
+{
+  set.U = 0;
+  for (const Task &t : set.aTask) {
+    set.U += (double)t.C / (double)t.T;
+  }
+  set.bFits = false;
+  set.bUndecided = false;
+  set.nSlack = 0;
+  set.nSlackAt = 0;
+  if (set.U > 1.0 + 1e-12 || set.aTask.empty()) {
+    return;
+  }
+  long L = busy_period(set);
+  if (L < 0) {
+    set.bUndecided = true;
+    return;
+  }
+  set.bFits = demand_test(set, L);
+  if (set.bFits) {
+    for (int i = 0; i < (int)set.aTask.size(); i++) {
+      set.aR.push_back(response_time(set, i, L));
+    }
+  }
+}
+
+/** \brief  read the task sets of a file
+
+    \param [in]      pFile: the file
+    \param [out]     aSet: the sets in file order
+    \return          true if the file was read without errors
+ */
+static bool read_sets(FILE *pFile, std::vector<TaskSet> &aSet)
+{
+  char aLine[256];
+  int nLine = 0;
+  while (fgets(aLine, sizeof(aLine), pFile) != NULL) {
+    char aName[128];
+    long C, T, D, B = 0;
+    nLine++;
+    char *p = aLine + strspn(aLine, " \t");
+    if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') {
+      continue;
+    }
+    if (sscanf(p, "set %127s", aName) == 1) {
+      aSet.push_back(TaskSet());
+      aSet.back().Name = aName;
+      aSet.back().nLine = nLine;
+    }
+    else if (sscanf(p, "task %ld %ld %ld %ld", &C, &T, &D, &B) >= 3) {
+      if (aSet.empty() || C <= 0 || T <= 0 || D <= 0 || B < 0 ||
+          T > EDF_HORIZON || D > EDF_HORIZON) {
+        fprintf(stderr, "line %d: bad task\n", nLine);
+        return false;
+      }
+      aSet.back().aTask.push_back(Task{ C + B, T, D });
+    }
+    else {
+      fprintf(stderr, "line %d: expected set or task\n", nLine);
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned nThreads = std::thread::hardware_concurrency();
+  bool bVerbose = false;
+  const char *pPath = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+      nThreads = (unsigned)atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "-v") == 0) {
+      bVerbose = true;
+    }
+    else {
+      pPath = argv[i];
+    }
+  }
+  if (pPath == NULL) {
+    fprintf(stderr, "usage: %s [-j threads] [-v] tasksets.txt\n", argv[0]);
+    return 2;
+  }
+  FILE *pFile = fopen(pPath, "r");
+  if (pFile == NULL) {
+    perror(pPath);
+    return 2;
+  }
+  std::vector<TaskSet> aSet;
+  bool bRead = read_sets(pFile, aSet);
+  fclose(pFile);
+  if (!bRead) {
+    return 2;
+  }
+
+  // Sets are handed out one at a time, they differ a lot in cost
+  std::atomic<size_t> nNext(0);
+  std::vector<std::thread> aWorker;
+  for (unsigned w = 0; w < std::max(nThreads, 1u); w++) {
+    aWorker.emplace_back([&]() {
+      for (size_t i; (i = nNext++) < aSet.size(); ) {
+        analyse(aSet[i]);
+      }
+    });
+  }
+  for (std::thread &w : aWorker) {
+    w.join();
+  }
+
+  size_t nFits = 0;
+  for (const TaskSet &set : aSet) {
+    if (set.bUndecided) {
+      printf("%s: undecided U=%.4f busy period beyond %d ticks\n",
+             set.Name.c_str(), set.U, EDF_HORIZON);
+      continue;
+    }
+    if (!set.bFits) {
+      if (set.U > 1.0 + 1e-12) {
+        printf("%s: overload U=%.4f\n", set.Name.c_str(), set.U);
+      }
+      else {
+        printf("%s: misses U=%.4f dbf exceeds t=%ld by %ld\n",
+               set.Name.c_str(), set.U, set.nSlackAt, -set.nSlack);
+      }
+      continue;
+    }
+    nFits++;
+    size_t nWorst = 0;
+    for (size_t i = 1; i < set.aR.size(); i++) {
+      if (set.aTask[i].D - set.aR[i] < set.aTask[nWorst].D - set.aR[nWorst]) {
+        nWorst = i;
+      }
+    }
+    printf("%s: fits U=%.4f slack=%ld at t=%ld task %zu R=%ld D=%ld",
+           set.Name.c_str(), set.U, set.nSlack, set.nSlackAt,
+           nWorst, set.aR[nWorst], set.aTask[nWorst].D);
+    if (bVerbose) {
+      printf(" R=");
+      for (size_t i = 0; i < set.aR.size(); i++) {
+        printf("%s%ld", i ? "," : "", set.aR[i]);
+      }
+    }
+    printf("\n");
+  }
+  fprintf(stderr, "%zu of %zu sets fit\n", nFits, aSet.size());
+  return nFits == aSet.size() ? 0 : 1;
+}
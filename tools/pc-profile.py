@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""ART Real Time Micro Kernel PC-sample profile
+
+Symbolizes the samples of the tick profiler (OSFunctions/PcSample.h,
+KERNEL_PC_SAMPLES) against the ELF image of the kernel and prints a flat
+profile per task. It runs on the host and is not part of the kernel
+build:
+
+    tools/pc-profile.py [--nm arm-none-eabi-nm] [-n lines] image.out samples
+
+The samples are either
+ - text, one sample per line as two hex numbers "PC Body", for example
+   printed by the application from pc_samples_read. Other lines
+   are ignored.
+ - with --raw, a little endian binary dump of pcRing taken in the
+   debugger. The ring is unrolled from its nCount.
+
+Tasks are named after the symbol of their body. A PC outside of every
+symbol is counted as "?".
+"""
+
+import argparse
+import bisect
+import collections
+import os
+import re
+import struct
+import subprocess
+import sys
+
+PC_SAMPLES = 1024       # as in PcSample.h
+
+
+def read_symbols(nm, image):
+    """Sorted (address, name) of the code symbols of the image."""
+    out = subprocess.run([nm, "-n", "-C", "--defined-only", image],
+                         check=True, stdout=subprocess.PIPE,
+                         universal_newlines=True).stdout
+    aAddr, aName = [], []
+    for line in out.splitlines():
+        part = line.split(None, 2)
+        if len(part) == 3 and part[1] in "TtWw":
+            aAddr.append(int(part[0], 16) & ~1)   # drop the Thumb bit
+            aName.append(part[2])
+    return aAddr, aName
+
+
+def symbolize(syms, nAddr):
+    aAddr, aName = syms
+    i = bisect.bisect_right(aAddr, nAddr & ~1) - 1
+    return aName[i] if i >= 0 else "?"
+
+
+def read_text(path):
+    hexpair = re.compile(r"^\s*(?:0x)?([0-9a-fA-F]+)[\s,]+(?:0x)?([0-9a-fA-F]+)\s*$")
+    aSample = []
+    with open(path) as f:
+        for line in f:
+            m = hexpair.match(line)
+            if m:
+                aSample.append((int(m.group(1), 16), int(m.group(2), 16)))
+    return aSample
+
+
+def read_raw(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    nRing = PC_SAMPLES * 8
+    if len(data) < nRing + 4:
+        sys.exit("%s: shorter than pcRing" % path)
+    nCount = struct.unpack_from("<I", data, nRing)[0]
+    aSample = []
+    nFirst = max(nCount - PC_SAMPLES, 0)
+    for n in range(nFirst, nCount):
+        aSample.append(struct.unpack_from("<II", data, (n % PC_SAMPLES) * 8))
+    return aSample
+
+
+def main():
+    parser = argparse.ArgumentParser(description="flat profile per task of PC samples")
+    parser.add_argument("--nm", default=os.environ.get("NM", "nm"), help="nm of the target toolchain")
+    parser.add_argument("--raw", action="store_true", help="samples are a binary dump of pcRing")
+    parser.add_argument("-n", type=int, default=20, help="functions listed per task")
+    parser.add_argument("image")
+    parser.add_argument("samples")
+    args = parser.parse_args()
+
+    syms = read_symbols(args.nm, args.image)
+    aSample = read_raw(args.samples) if args.raw else read_text(args.samples)
+    if not aSample:
+        sys.exit("%s: no samples" % args.samples)
+
+    tasks = collections.defaultdict(collections.Counter)
+    for nPC, nBody in aSample:
+        tasks[symbolize(syms, nBody)][symbolize(syms, nPC)] += 1
+
+    nTotal = len(aSample)
+    print("%d samples" % nTotal)
+    for task, funcs in sorted(tasks.items(), key=lambda t: -sum(t[1].values())):
+        nTask = sum(funcs.values())
+        print("\ntask %s: %d samples %.1f%%" % (task, nTask, 100.0 * nTask / nTotal))
+        print("  %8s %6s %6s  %s" % ("samples", "task%", "all%", "function"))
+        for func, n in funcs.most_common(args.n):
+            print("  %8d %6.1f %6.1f  %s" % (n, 100.0 * n / nTask, 100.0 * n / nTotal, func))
+
+
+if __name__ == "__main__":
+    main()